@@ -1,18 +1,179 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <functional>
 #include <initializer_list>
+#include <numeric>
 #include <span>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 #include <mpi.h>
 
 #include "comm.hpp"
+#include "dims.hpp"
 #include "error.hpp"
+#include "neighbor_collectives.hpp"
 
 namespace cxxmpi {
 
+namespace detail {
+
+// Cartesian dimensions supported by basic_cart_comm; the topology is stored
+// inline, without allocation
+inline constexpr std::size_t max_cart_dims = 8;
+
+// Topology of a cartesian communicator, queried once at construction. MPI
+// numbers the processes of a cartesian communicator in row-major order of
+// their coordinates, so rank/coordinate conversions and shifts are plain
+// arithmetic.
+class cart_topology {
+ public:
+  cart_topology() = default;
+
+  explicit cart_topology(MPI_Comm mpi_comm) {
+    int num_dims = 0;
+    check_mpi_result(MPI_Cartdim_get(mpi_comm, &num_dims));
+    if (static_cast<std::size_t>(num_dims) > max_cart_dims) {
+      throw std::invalid_argument("too many cartesian dimensions");
+    }
+    ndims_ = static_cast<std::size_t>(num_dims);
+    check_mpi_result(MPI_Cart_get(mpi_comm, num_dims, dims_.data(),
+                                  periods_.data(), coords_.data()));
+    check_mpi_result(MPI_Comm_rank(mpi_comm, &rank_));
+
+    int stride = 1;
+    for (auto d = ndims_; d-- > 0;) {
+      strides_[d] = stride;
+      stride *= dims_[d];
+    }
+    size_ = stride;
+    for (std::size_t d = 0; d < ndims_; ++d) {
+      neighbors_[2 * d] = shifted(d, -1);
+      neighbors_[(2 * d) + 1] = shifted(d, 1);
+    }
+  }
+
+  [[nodiscard]]
+  auto ndims() const noexcept -> std::size_t {
+    return ndims_;
+  }
+
+  [[nodiscard]]
+  auto dims() const noexcept -> std::span<const int> {
+    return {dims_.data(), ndims_};
+  }
+
+  [[nodiscard]]
+  auto periodic(std::size_t direction) const noexcept -> bool {
+    assert(direction < ndims_);
+    return periods_[direction] != 0;
+  }
+
+  [[nodiscard]]
+  auto coords() const noexcept -> std::span<const int> {
+    return {coords_.data(), ndims_};
+  }
+
+  // Negative then positive unit-shift neighbor of each dimension
+  [[nodiscard]]
+  auto neighbors() const noexcept -> std::span<const int> {
+    return {neighbors_.data(), 2 * ndims_};
+  }
+
+  void coords(int rank, std::span<int> out) const {
+    if (rank < 0 || rank >= size_) {
+      throw mpi_error{MPI_ERR_RANK};
+    }
+    assert(out.size() == ndims_);
+    for (std::size_t d = 0; d < ndims_; ++d) {
+      out[d] = rank / strides_[d] % dims_[d];
+    }
+  }
+
+  // Coordinates outside a periodic dimension wrap around
+  [[nodiscard]]
+  auto rank(std::span<const int> coords) const -> int {
+    assert(coords.size() == ndims_);
+    int result = 0;
+    for (std::size_t d = 0; d < ndims_; ++d) {
+      auto const c = wrap(d, coords[d]);
+      if (c < 0) {
+        throw mpi_error{MPI_ERR_ARG};
+      }
+      result += c * strides_[d];
+    }
+    return result;
+  }
+
+  // Rank displaced by offset from this process, MPI_PROC_NULL beyond a
+  // non-periodic boundary
+  [[nodiscard]]
+  auto neighbor(std::span<const int> offset) const noexcept -> int {
+    assert(offset.size() == ndims_);
+    int result = rank_;
+    for (std::size_t d = 0; d < ndims_; ++d) {
+      auto const c = wrap(d, coords_[d] + offset[d]);
+      if (c < 0) {
+        return MPI_PROC_NULL;
+      }
+      result += (c - coords_[d]) * strides_[d];
+    }
+    return result;
+  }
+
+  [[nodiscard]]
+  auto shift(std::size_t direction, int disp) const
+      -> std::pair<int, int> {
+    if (direction >= ndims_) {
+      throw mpi_error{MPI_ERR_DIMS};
+    }
+    if (disp == 1) {
+      return {neighbors_[2 * direction], neighbors_[(2 * direction) + 1]};
+    }
+    return {shifted(direction, -disp), shifted(direction, disp)};
+  }
+
+ private:
+  std::size_t ndims_{0};
+  int rank_{MPI_PROC_NULL};
+  int size_{0};
+  std::array<int, max_cart_dims> dims_{};
+  std::array<int, max_cart_dims> periods_{};
+  std::array<int, max_cart_dims> coords_{};
+  std::array<int, max_cart_dims> strides_{};
+  std::array<int, 2 * max_cart_dims> neighbors_{};
+
+  // Coordinate c of direction mapped into the grid, -1 if it lies beyond a
+  // non-periodic boundary
+  [[nodiscard]]
+  auto wrap(std::size_t direction, int c) const noexcept -> int {
+    auto const n = dims_[direction];
+    if (c >= 0 && c < n) {
+      return c;
+    }
+    if (periods_[direction] == 0) {
+      return -1;
+    }
+    return ((c % n) + n) % n;
+  }
+
+  [[nodiscard]]
+  auto shifted(std::size_t direction, int disp) const noexcept -> int {
+    auto const c = wrap(direction, coords_[direction] + disp);
+    if (c < 0) {
+      return MPI_PROC_NULL;
+    }
+    return rank_ + ((c - coords_[direction]) * strides_[direction]);
+  }
+};
+
+}  // namespace detail
+
 struct neighbors_2d {
   int up;
   int down;
@@ -21,7 +182,9 @@ struct neighbors_2d {
 };
 
 template <typename Handle = comm_handle>
-class basic_cart_comm : public basic_comm<Handle> {
+class basic_cart_comm
+    : public basic_comm<Handle>,
+      public neighbor_collectives<basic_cart_comm<Handle>> {
  public:
   using handle_type = Handle;
 
@@ -37,12 +200,13 @@ class basic_cart_comm : public basic_comm<Handle> {
   // weak_cart_comm can be copyable / assignable
   constexpr basic_cart_comm(const basic_cart_comm& other)
     requires std::is_copy_constructible_v<Handle>
-      : basic_comm<Handle>{other} {}
+      : basic_comm<Handle>{other}, topology_{other.topology_} {}
   constexpr auto operator=(const basic_cart_comm& other) -> basic_cart_comm&
     requires std::is_copy_assignable_v<Handle>
   {
     if (this != &other) {
       basic_comm<Handle>::operator=(other);
+      topology_ = other.topology_;
     }
     return *this;
   }
@@ -50,14 +214,22 @@ class basic_cart_comm : public basic_comm<Handle> {
   // cart_comm to weak_cart_comm conversion constructor
   constexpr explicit basic_cart_comm(const basic_cart_comm<comm_handle>& other)
     requires std::same_as<Handle, weak_comm_handle>
-      : basic_comm<Handle>{other} {}
+      : basic_comm<Handle>{other}, topology_{other.topology_} {}
 
+  // Takes ownership of a communicator with a cartesian topology
+  explicit basic_cart_comm(handle_type handle)
+      : basic_comm<Handle>{std::move(handle)}, topology_{this->native()} {}
+
+  // With reorder, processes sharing a node are given a compact block of the
+  // grid when the nodes are equally populated and tile it, so most halo
+  // traffic stays within a node. Otherwise the reordering is left to MPI.
   template <typename BaseHandle>
   basic_cart_comm(const basic_comm<BaseHandle>& base,
                   std::span<const size_t> dims,
                   std::span<const bool> periods,
                   bool reorder)
-      : basic_comm<Handle>{create_cart_comm(base, dims, periods, reorder)} {}
+      : basic_comm<Handle>{create_cart_comm(base, dims, periods, reorder)},
+        topology_{this->native()} {}
 
   template <typename BaseHandle>
   basic_cart_comm(const basic_comm<BaseHandle>& base,
@@ -67,47 +239,94 @@ class basic_cart_comm : public basic_comm<Handle> {
       : basic_cart_comm{base, std::span{dims.begin(), dims.size()},
                         std::span{periods.begin(), periods.size()}, reorder} {}
 
+  // Reorders for a grid from create_dims(base, domain): the node blocks are
+  // chosen for the cells of domain, as create_dims assumed, rather than for
+  // the grid alone
+  template <typename BaseHandle>
+  basic_cart_comm(const basic_comm<BaseHandle>& base,
+                  std::span<const size_t> dims,
+                  std::span<const bool> periods,
+                  std::span<const int> domain)
+      : basic_comm<Handle>{create_cart_comm(base, dims, periods, true,
+                                            domain)},
+        topology_{this->native()} {}
+
+  template <typename BaseHandle>
+  basic_cart_comm(const basic_comm<BaseHandle>& base,
+                  std::initializer_list<size_t> dims,
+                  std::initializer_list<bool> periods,
+                  std::initializer_list<int> domain)
+      : basic_cart_comm{base, std::span{dims.begin(), dims.size()},
+                        std::span{periods.begin(), periods.size()},
+                        std::span{domain.begin(), domain.size()}} {}
+
+  // The topology accessors below are answered from a copy taken at
+  // construction and do not call MPI
+
   [[nodiscard]]
-  auto ndims() const -> std::size_t {
-    int ndims = 0;
-    check_mpi_result(MPI_Cartdim_get(this->native(), &ndims));
-    return static_cast<size_t>(ndims);
+  auto ndims() const noexcept -> std::size_t {
+    return topology_.ndims();
   }
 
+  // Each dimension has a negative and a positive neighbor, MPI_PROC_NULL
+  // at a non-periodic boundary
   [[nodiscard]]
-  auto dims() const -> std::vector<int> {
-    auto const num_dims = ndims();
+  auto in_degree() const noexcept -> std::size_t {
+    return 2 * ndims();
+  }
 
-    auto dims = std::vector<int>(num_dims);
-    auto periods = std::vector<int>(num_dims);
-    auto coords = std::vector<int>(num_dims);
+  [[nodiscard]]
+  auto out_degree() const noexcept -> std::size_t {
+    return 2 * ndims();
+  }
 
-    check_mpi_result(MPI_Cart_get(this->native(), static_cast<int>(num_dims),
-                                  dims.data(), periods.data(), coords.data()));
+  [[nodiscard]]
+  auto dims() const -> std::vector<int> {
+    auto const cached = topology_.dims();
+    return {cached.begin(), cached.end()};
+  }
 
-    return dims;
+  // Allocation-free variant of dims(), valid while the communicator is
+  [[nodiscard]]
+  auto dims_view() const noexcept -> std::span<const int> {
+    return topology_.dims();
+  }
+
+  [[nodiscard]]
+  auto periodic(std::size_t direction) const noexcept -> bool {
+    return topology_.periodic(direction);
   }
 
   [[nodiscard]]
   auto coords(int rank) const -> std::vector<int> {
     std::vector<int> coords(ndims());
-    check_mpi_result(MPI_Cart_coords(
-        this->native(), rank, static_cast<int>(coords.size()), coords.data()));
+    topology_.coords(rank, coords);
     return coords;
   }
 
+  // Allocation-free variant; out must have ndims() entries
+  void coords(int rank, std::span<int> out) const {
+    topology_.coords(rank, out);
+  }
+
   [[nodiscard]]
   auto coords() const -> std::vector<int> {
-    return coords(this->rank());
+    auto const own = topology_.coords();
+    return {own.begin(), own.end()};
+  }
+
+  // Coordinate of this process in direction
+  [[nodiscard]]
+  auto coord(std::size_t direction) const noexcept -> int {
+    assert(direction < ndims());
+    return topology_.coords()[direction];
   }
 
   using basic_comm<Handle>::rank;
 
   [[nodiscard]]
   auto rank(std::span<const int> coords) const -> int {
-    int rank = MPI_PROC_NULL;
-    check_mpi_result(MPI_Cart_rank(this->native(), coords.data(), &rank));
-    return rank;
+    return topology_.rank(coords);
   }
 
   [[nodiscard]]
@@ -115,20 +334,73 @@ class basic_cart_comm : public basic_comm<Handle> {
     return rank(std::span{coords.begin(), coords.size()});
   }
 
+  // Rank displaced from this process by one offset per dimension, e.g.
+  // {1, -1} for a diagonal neighbor; MPI_PROC_NULL beyond a non-periodic
+  // boundary
+  [[nodiscard]]
+  auto neighbor(std::span<const int> offset) const noexcept -> int {
+    return topology_.neighbor(offset);
+  }
+
+  // Unit-shift neighbors, negative then positive for each dimension; the
+  // neighbor collectives use the same order
+  [[nodiscard]]
+  auto neighbors() const noexcept -> std::span<const int> {
+    return topology_.neighbors();
+  }
+
   // Get ranks of neighboring processes
   [[nodiscard]]
   auto shift(int direction, int disp) const -> std::pair<int, int> {
-    int source, dest;  // NOLINT
-    check_mpi_result(
-        MPI_Cart_shift(this->native(), direction, disp, &source, &dest));
-    return {source, dest};
+    if (direction < 0) {
+      throw mpi_error{MPI_ERR_DIMS};
+    }
+    return topology_.shift(static_cast<std::size_t>(direction), disp);
+  }
+
+  // Sends to the neighbor disp steps along direction and receives from the
+  // one disp steps against it; at a non-periodic edge the missing side is
+  // MPI_PROC_NULL and is skipped
+  template <typename T, size_t SendExtent, size_t RecvExtent>
+  auto exchange(int direction,
+                int disp,
+                std::span<const T, SendExtent> send_data,
+                std::span<T, RecvExtent> recv_data,
+                int tag = 0) const -> status {
+    auto [source, dest] = shift(direction, disp);
+    return this->sendrecv(send_data, dest, recv_data, source, tag);
+  }
+
+  // Sub-grid of the dimensions flagged in remain_dims that contains this
+  // process, e.g. {false, true} for the rows of a 2D grid
+  [[nodiscard]]
+  auto cart_sub(std::span<const bool> remain_dims) const
+      -> basic_cart_comm<comm_handle> {
+    if (remain_dims.size() != ndims()) {
+      throw std::invalid_argument(
+          "remain_dims must have one entry per dimension");
+    }
+    std::array<int, detail::max_cart_dims> remain{};
+    std::ranges::transform(remain_dims, remain.begin(),
+                           [](bool r) { return r ? 1 : 0; });
+    MPI_Comm sub = MPI_COMM_NULL;
+    check_mpi_result(MPI_Cart_sub(this->native(), remain.data(), &sub));
+    return basic_cart_comm<comm_handle>{comm_handle{weak_comm_handle{sub}}};
+  }
+
+  [[nodiscard]]
+  auto cart_sub(std::initializer_list<bool> remain_dims) const
+      -> basic_cart_comm<comm_handle> {
+    return cart_sub(std::span{remain_dims.begin(), remain_dims.size()});
   }
 
   [[nodiscard]]
   auto neighbors_2d() const -> neighbors_2d {
-    auto [up, down] = shift(0, 1);
-    auto [left, right] = shift(1, 1);
-    return {up, down, left, right};
+    auto const table = neighbors();
+    if (table.size() < 4) {
+      throw mpi_error{MPI_ERR_DIMS};
+    }
+    return {table[0], table[1], table[2], table[3]};
   }
 
  private:
@@ -136,10 +408,18 @@ class basic_cart_comm : public basic_comm<Handle> {
   static auto create_cart_comm(const basic_comm<BaseHandle>& base,
                                std::span<const size_t> dims,
                                std::span<const bool> periods,
-                               bool reorder) -> handle_type {
+                               bool reorder,
+                               std::span<const int> domain = {})
+      -> handle_type {
     if (dims.size() != periods.size()) {
       throw std::invalid_argument("dims and periods must have same size");
     }
+    if (!domain.empty() && domain.size() != dims.size()) {
+      throw std::invalid_argument("dims and domain must have same size");
+    }
+    if (dims.size() > detail::max_cart_dims) {
+      throw std::invalid_argument("too many cartesian dimensions");
+    }
 
     std::vector<int> periods_int(dims.size());
     std::ranges::transform(periods, periods_int.begin(),
@@ -148,12 +428,73 @@ class basic_cart_comm : public basic_comm<Handle> {
     std::ranges::transform(dims, dims_int.begin(),
                            [](size_t d) { return static_cast<int>(d); });
 
+    // Without a domain the grid itself stands in for it
+    std::span<const int> const cells =
+        domain.empty() ? std::span<const int>{dims_int} : domain;
     weak_comm_handle new_comm;
-    check_mpi_result(MPI_Cart_create(
-        base.native(), static_cast<int>(dims.size()), dims_int.data(),
-        periods_int.data(), static_cast<int>(reorder), &new_comm.native()));
+    auto const ordered =
+        reorder ? node_ordered_comm(base, dims_int, cells) : comm_handle{};
+    if (ordered) {
+      // Already renumbered; MPI must keep this order
+      check_mpi_result(MPI_Cart_create(
+          ordered->native(), static_cast<int>(dims.size()), dims_int.data(),
+          periods_int.data(), 0, &new_comm.native()));
+    } else {
+      check_mpi_result(MPI_Cart_create(
+          base.native(), static_cast<int>(dims.size()), dims_int.data(),
+          periods_int.data(), static_cast<int>(reorder), &new_comm.native()));
+    }
     return handle_type{new_comm};
   }
+
+  // base renumbered so that the processes of each node form the block of
+  // the grid with the least inter-node halo for domain. Null if the grid
+  // does not cover base or the nodes are not equally populated; every
+  // process reaches the same decision.
+  template <typename BaseHandle>
+  static auto node_ordered_comm(const basic_comm<BaseHandle>& base,
+                                std::span<const int> dims,
+                                std::span<const int> domain) -> comm_handle {
+    auto const total =
+        std::accumulate(dims.begin(), dims.end(), 1, std::multiplies<>{});
+    if (total != static_cast<int>(base.size())) {
+      return {};
+    }
+
+    auto const node = base.split_type(split_kind::shared);
+    auto const ppn = static_cast<int>(node.size());
+
+    // Nodes are identified and ordered by their lowest rank in base
+    int leader = base.rank();
+    node.bcast(leader);
+    auto leaders = base.allgather(leader);
+    std::ranges::sort(leaders);
+    for (auto it = leaders.begin(); it != leaders.end();) {
+      auto const next = std::upper_bound(it, leaders.end(), *it);
+      if (next - it != ppn) {
+        return {};
+      }
+      it = next;
+    }
+
+    auto const block = detail::best_node_block(domain, dims, ppn).block;
+    if (block.empty()) {
+      return {};
+    }
+    auto const node_index = static_cast<int>(
+        std::ranges::lower_bound(leaders, leader) - leaders.begin()) / ppn;
+    auto const key =
+        detail::node_block_rank(dims, block, node_index, node.rank());
+
+    MPI_Comm ordered = MPI_COMM_NULL;
+    check_mpi_result(MPI_Comm_split(base.native(), 0, key, &ordered));
+    return comm_handle{weak_comm_handle{ordered}};
+  }
+
+  template <typename>
+  friend class basic_cart_comm;
+
+  detail::cart_topology topology_;
 };
 
 using cart_comm = basic_cart_comm<comm_handle>;
@@ -1,13 +1,24 @@
 #pragma once
 
+#include <algorithm>
+#include <cassert>
 #include <cstddef>
 #include <memory>
+#include <numeric>
+#include <optional>
 #include <span>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include <mpi.h>
 
 #include "cxxmpi/dtype.hpp"
 #include "cxxmpi/error.hpp"
+#include "cxxmpi/message.hpp"
+#include "cxxmpi/op.hpp"
+#include "cxxmpi/persistent_channel.hpp"
+#include "cxxmpi/persistent_collective.hpp"
 #include "cxxmpi/request.hpp"
 #include "cxxmpi/status.hpp"
 
@@ -23,6 +34,21 @@ concept is_std_span = requires {
 
 }  // namespace detail
 
+// Concatenated contributions of every rank, as returned by allgatherv
+template <typename T>
+struct gathered {
+  std::vector<T> values;
+  std::vector<int> counts;
+  std::vector<int> displs;
+
+  [[nodiscard]]
+  auto operator[](std::size_t rank) const -> std::span<const T> {
+    return std::span<const T>{values}.subspan(
+        static_cast<std::size_t>(displs[rank]),
+        static_cast<std::size_t>(counts[rank]));
+  }
+};
+
 class weak_comm_handle {
   MPI_Comm comm_{MPI_COMM_NULL};
 
@@ -98,6 +124,12 @@ struct comm_deleter {
 
 using comm_handle = std::unique_ptr<weak_comm_handle, detail::comm_deleter>;
 
+// Kinds of basic_comm::split_type
+enum class split_kind : int {
+  // Processes that can create shared memory, i.e. share a node
+  shared = MPI_COMM_TYPE_SHARED,
+};
+
 template <typename Handle = comm_handle>
 class basic_comm {
  public:
@@ -161,6 +193,23 @@ class basic_comm {
 
   void barrier() const { check_mpi_result(MPI_Barrier(native())); }
 
+  // Groups the processes by kind, e.g. one communicator per node for
+  // split_kind::shared; key orders the ranks within each group
+  [[nodiscard]]
+  auto split_type(split_kind kind, int key) const -> basic_comm<comm_handle> {
+    MPI_Comm new_comm = MPI_COMM_NULL;
+    check_mpi_result(MPI_Comm_split_type(native(), static_cast<int>(kind),
+                                         key, MPI_INFO_NULL, &new_comm));
+    return basic_comm<comm_handle>{comm_handle{weak_comm_handle{new_comm}}};
+  }
+
+  // Keeps the relative order of the ranks
+  [[nodiscard]]
+  auto split_type(split_kind kind = split_kind::shared) const
+      -> basic_comm<comm_handle> {
+    return split_type(kind, rank_);
+  }
+
   // Blocking send - custom datatype with count
   template <typename T, size_t Extent>
   void send(std::span<const T, Extent> data,
@@ -262,6 +311,188 @@ class basic_comm {
           request);
   }
 
+  // Non-blocking send returning an owning request - builtin datatype
+  template <typename T, size_t Extent>
+  [[nodiscard]]
+  auto isend(std::span<const T, Extent> data,
+             int dest,
+             int tag = 0) const -> request {
+    request req;
+    isend(data, dest, tag, req.native());
+    return req;
+  }
+
+  // Non-blocking receive returning an owning request - builtin datatype
+  template <typename T, size_t Extent>
+  [[nodiscard]]
+  auto irecv(std::span<T, Extent> data,
+             int source,
+             int tag = 0) const -> request {
+    request req;
+    irecv(data, source, tag, req.native());
+    return req;
+  }
+
+  // Non-blocking send that takes over the buffer until completion; get()
+  // returns it for reuse
+  template <typename T>
+  [[nodiscard]]
+  auto isend(std::vector<T>&& data,
+             int dest,
+             int tag = 0) const -> future<std::vector<T>> {
+    auto req = isend(std::span<const T>{data}, dest, tag);
+    return {std::move(data), std::move(req)};
+  }
+
+  // Non-blocking receive into an owned buffer sized by the caller
+  template <typename T>
+  [[nodiscard]]
+  auto irecv(std::vector<T>&& data,
+             int source,
+             int tag = 0) const -> future<std::vector<T>> {
+    auto req = irecv(std::span<T>{data}, source, tag);
+    return {std::move(data), std::move(req)};
+  }
+
+  // Combined send and receive - custom datatypes with counts
+  template <typename T, size_t SendExtent, typename U, size_t RecvExtent>
+  auto sendrecv(std::span<const T, SendExtent> send_data,
+                const weak_dtype& send_type,
+                int send_count,
+                int dest,
+                int send_tag,
+                std::span<U, RecvExtent> recv_data,
+                const weak_dtype& recv_type,
+                int recv_count,
+                int source,
+                int recv_tag) const -> status {
+    status st;
+    check_mpi_result(MPI_Sendrecv(send_data.data(), send_count,
+                                  send_type.native(), dest, send_tag,
+                                  recv_data.data(), recv_count,
+                                  recv_type.native(), source, recv_tag,
+                                  native(), &st.native()));
+    return st;
+  }
+
+  // Combined send and receive - builtin datatype
+  template <typename T, size_t SendExtent, size_t RecvExtent>
+  auto sendrecv(std::span<const T, SendExtent> send_data,
+                int dest,
+                std::span<T, RecvExtent> recv_data,
+                int source,
+                int tag = 0) const -> status {
+    return sendrecv(send_data, as_weak_dtype<T>(),
+                    static_cast<int>(send_data.size()), dest, tag, recv_data,
+                    as_weak_dtype<T>(), static_cast<int>(recv_data.size()),
+                    source, tag);
+  }
+
+  template <typename T>
+  auto sendrecv(const T& send_value,
+                int dest,
+                T& recv_value,
+                int source,
+                int tag = 0) const -> status
+    requires(!detail::is_std_span<T>)
+  {
+    return sendrecv(std::span<const T, 1>(&send_value, 1), dest,
+                    std::span<T, 1>(&recv_value, 1), source, tag);
+  }
+
+  // Sends data and overwrites it with the received message - custom
+  // datatype with count
+  template <typename T, size_t Extent>
+  auto sendrecv_replace(std::span<T, Extent> data,
+                        const weak_dtype& data_type,
+                        int count,
+                        int dest,
+                        int send_tag,
+                        int source,
+                        int recv_tag) const -> status {
+    status st;
+    check_mpi_result(MPI_Sendrecv_replace(data.data(), count,
+                                          data_type.native(), dest, send_tag,
+                                          source, recv_tag, native(),
+                                          &st.native()));
+    return st;
+  }
+
+  template <typename T, size_t Extent>
+  auto sendrecv_replace(std::span<T, Extent> data,
+                        int dest,
+                        int source,
+                        int tag = 0) const -> status {
+    return sendrecv_replace(data, as_weak_dtype<T>(),
+                            static_cast<int>(data.size()), dest, tag, source,
+                            tag);
+  }
+
+  template <typename T>
+  auto sendrecv_replace(T& value, int dest, int source, int tag = 0) const
+      -> status
+    requires(!detail::is_std_span<T>)
+  {
+    return sendrecv_replace(std::span<T, 1>(&value, 1), dest, source, tag);
+  }
+
+  // Blocks until a matching message is available without receiving it
+  [[nodiscard]]
+  auto probe(int source, int tag) const -> status {
+    status st;
+    check_mpi_result(MPI_Probe(source, tag, native(), &st.native()));
+    return st;
+  }
+
+  [[nodiscard]]
+  auto iprobe(int source, int tag) const -> std::optional<status> {
+    status st;
+    int flag = 0;
+    check_mpi_result(MPI_Iprobe(source, tag, native(), &flag, &st.native()));
+    if (flag == 0) {
+      return std::nullopt;
+    }
+    return st;
+  }
+
+  // Matches a message and removes it from the queue; receive it through the
+  // returned message
+  [[nodiscard]]
+  auto mprobe(int source, int tag) const -> std::pair<message, status> {
+    MPI_Message msg = MPI_MESSAGE_NULL;
+    status st;
+    check_mpi_result(MPI_Mprobe(source, tag, native(), &msg, &st.native()));
+    return {message{msg}, st};
+  }
+
+  [[nodiscard]]
+  auto improbe(int source, int tag) const
+      -> std::optional<std::pair<message, status>> {
+    MPI_Message msg = MPI_MESSAGE_NULL;
+    status st;
+    int flag = 0;
+    check_mpi_result(
+        MPI_Improbe(source, tag, native(), &flag, &msg, &st.native()));
+    if (flag == 0) {
+      return std::nullopt;
+    }
+    return std::pair{message{msg}, st};
+  }
+
+  // Receives a message of unknown length, sizing data to it exactly
+  template <typename T>
+  auto recv(std::vector<T>& data, int source, int tag = 0) const -> status {
+    auto [msg, st] = mprobe(source, tag);
+    data.resize(matched_count<T>(st));
+    return msg.recv(std::span<T>{data});
+  }
+
+  auto recv(std::string& data, int source, int tag = 0) const -> status {
+    auto [msg, st] = mprobe(source, tag);
+    data.resize(matched_count<char>(st));
+    return msg.recv(std::span<char>{data});
+  }
+
   // Single value overloads
   template <typename T>
   void send(const T& value, int dest, int tag = 0) const
@@ -298,6 +529,941 @@ class basic_comm {
     irecv(std::span<T, 1>(&value, 1), source, tag, request);
   }
 
+  // Persistent send - custom datatype with count
+  template <typename T, size_t Extent>
+  [[nodiscard]]
+  auto send_init(std::span<const T, Extent> data,
+                 const weak_dtype& data_type,
+                 int count,
+                 int dest,
+                 int tag = 0) const -> persistent_channel {
+    MPI_Request req = MPI_REQUEST_NULL;
+    check_mpi_result(MPI_Send_init(data.data(), count, data_type.native(),
+                                   dest, tag, native(), &req));
+    return persistent_channel{req};
+  }
+
+  // Persistent send - builtin datatype with count
+  template <typename T, size_t Extent>
+  [[nodiscard]]
+  auto send_init(std::span<const T, Extent> data,
+                 int dest,
+                 int tag = 0) const -> persistent_channel {
+    return send_init(data, as_weak_dtype<T>(), static_cast<int>(data.size()),
+                     dest, tag);
+  }
+
+  // Persistent receive - custom datatype with count
+  template <typename T, size_t Extent>
+  [[nodiscard]]
+  auto recv_init(std::span<T, Extent> data,
+                 const weak_dtype& data_type,
+                 int count,
+                 int source,
+                 int tag = 0) const -> persistent_channel {
+    MPI_Request req = MPI_REQUEST_NULL;
+    check_mpi_result(MPI_Recv_init(data.data(), count, data_type.native(),
+                                   source, tag, native(), &req));
+    return persistent_channel{req};
+  }
+
+  // Persistent receive - builtin datatype with count
+  template <typename T, size_t Extent>
+  [[nodiscard]]
+  auto recv_init(std::span<T, Extent> data,
+                 int source,
+                 int tag = 0) const -> persistent_channel {
+    return recv_init(data, as_weak_dtype<T>(), static_cast<int>(data.size()),
+                     source, tag);
+  }
+
+  // Allreduce - custom datatype with count
+  template <typename T, size_t SendExtent, size_t RecvExtent, reduction_op Op>
+  void allreduce(std::span<const T, SendExtent> send_data,
+                 std::span<T, RecvExtent> recv_data,
+                 const weak_dtype& data_type,
+                 int count,
+                 const Op& operation) const {
+    check_mpi_result(MPI_Allreduce(send_data.data(), recv_data.data(), count,
+                                   data_type.native(),
+                                   detail::native_op(operation), native()));
+  }
+
+  // Allreduce - builtin datatype with count
+  template <typename T, size_t SendExtent, size_t RecvExtent, reduction_op Op>
+  void allreduce(std::span<const T, SendExtent> send_data,
+                 std::span<T, RecvExtent> recv_data,
+                 const Op& operation) const {
+    allreduce(send_data, recv_data, as_weak_dtype<T>(),
+              static_cast<int>(send_data.size()), operation);
+  }
+
+  // In-place allreduce - custom datatype with count
+  template <typename T, size_t Extent, reduction_op Op>
+  void allreduce(std::span<T, Extent> data,
+                 const weak_dtype& data_type,
+                 int count,
+                 const Op& operation) const {
+    check_mpi_result(MPI_Allreduce(MPI_IN_PLACE, data.data(), count,
+                                   data_type.native(),
+                                   detail::native_op(operation), native()));
+  }
+
+  // In-place allreduce - builtin datatype with count
+  template <typename T, size_t Extent, reduction_op Op>
+  void allreduce(std::span<T, Extent> data, const Op& operation) const {
+    allreduce(data, as_weak_dtype<T>(), static_cast<int>(data.size()),
+              operation);
+  }
+
+  // Reduce - custom datatype with count
+  // recv_data is only significant at root
+  template <typename T, size_t SendExtent, size_t RecvExtent, reduction_op Op>
+  void reduce(std::span<const T, SendExtent> send_data,
+              std::span<T, RecvExtent> recv_data,
+              const weak_dtype& data_type,
+              int count,
+              const Op& operation,
+              int root = 0) const {
+    check_mpi_result(MPI_Reduce(send_data.data(), recv_data.data(), count,
+                                data_type.native(),
+                                detail::native_op(operation), root, native()));
+  }
+
+  // Reduce - builtin datatype with count
+  template <typename T, size_t SendExtent, size_t RecvExtent, reduction_op Op>
+  void reduce(std::span<const T, SendExtent> send_data,
+              std::span<T, RecvExtent> recv_data,
+              const Op& operation,
+              int root = 0) const {
+    reduce(send_data, recv_data, as_weak_dtype<T>(),
+           static_cast<int>(send_data.size()), operation, root);
+  }
+
+  // In-place reduce - custom datatype with count
+  // The result overwrites data at root; data is left untouched elsewhere
+  template <typename T, size_t Extent, reduction_op Op>
+  void reduce(std::span<T, Extent> data,
+              const weak_dtype& data_type,
+              int count,
+              const Op& operation,
+              int root = 0) const {
+    if (rank_ == root) {
+      check_mpi_result(MPI_Reduce(MPI_IN_PLACE, data.data(), count,
+                                  data_type.native(),
+                                  detail::native_op(operation), root,
+                                  native()));
+    } else {
+      check_mpi_result(MPI_Reduce(data.data(), nullptr, count,
+                                  data_type.native(),
+                                  detail::native_op(operation), root,
+                                  native()));
+    }
+  }
+
+  // In-place reduce - builtin datatype with count
+  template <typename T, size_t Extent, reduction_op Op>
+  void reduce(std::span<T, Extent> data,
+              const Op& operation,
+              int root = 0) const {
+    reduce(data, as_weak_dtype<T>(), static_cast<int>(data.size()), operation,
+           root);
+  }
+
+  // Inclusive scan - custom datatype with count
+  template <typename T, size_t SendExtent, size_t RecvExtent, reduction_op Op>
+  void scan(std::span<const T, SendExtent> send_data,
+            std::span<T, RecvExtent> recv_data,
+            const weak_dtype& data_type,
+            int count,
+            const Op& operation) const {
+    check_mpi_result(MPI_Scan(send_data.data(), recv_data.data(), count,
+                              data_type.native(), detail::native_op(operation),
+                              native()));
+  }
+
+  // Inclusive scan - builtin datatype with count
+  template <typename T, size_t SendExtent, size_t RecvExtent, reduction_op Op>
+  void scan(std::span<const T, SendExtent> send_data,
+            std::span<T, RecvExtent> recv_data,
+            const Op& operation) const {
+    scan(send_data, recv_data, as_weak_dtype<T>(),
+         static_cast<int>(send_data.size()), operation);
+  }
+
+  // In-place inclusive scan - custom datatype with count
+  template <typename T, size_t Extent, reduction_op Op>
+  void scan(std::span<T, Extent> data,
+            const weak_dtype& data_type,
+            int count,
+            const Op& operation) const {
+    check_mpi_result(MPI_Scan(MPI_IN_PLACE, data.data(), count,
+                              data_type.native(), detail::native_op(operation),
+                              native()));
+  }
+
+  // In-place inclusive scan - builtin datatype with count
+  template <typename T, size_t Extent, reduction_op Op>
+  void scan(std::span<T, Extent> data, const Op& operation) const {
+    scan(data, as_weak_dtype<T>(), static_cast<int>(data.size()), operation);
+  }
+
+  // Exclusive scan - custom datatype with count
+  // recv_data is left undefined at rank 0
+  template <typename T, size_t SendExtent, size_t RecvExtent, reduction_op Op>
+  void exscan(std::span<const T, SendExtent> send_data,
+              std::span<T, RecvExtent> recv_data,
+              const weak_dtype& data_type,
+              int count,
+              const Op& operation) const {
+    check_mpi_result(MPI_Exscan(send_data.data(), recv_data.data(), count,
+                                data_type.native(),
+                                detail::native_op(operation), native()));
+  }
+
+  // Exclusive scan - builtin datatype with count
+  template <typename T, size_t SendExtent, size_t RecvExtent, reduction_op Op>
+  void exscan(std::span<const T, SendExtent> send_data,
+              std::span<T, RecvExtent> recv_data,
+              const Op& operation) const {
+    exscan(send_data, recv_data, as_weak_dtype<T>(),
+           static_cast<int>(send_data.size()), operation);
+  }
+
+  // In-place exclusive scan - custom datatype with count
+  // data is left undefined at rank 0
+  template <typename T, size_t Extent, reduction_op Op>
+  void exscan(std::span<T, Extent> data,
+              const weak_dtype& data_type,
+              int count,
+              const Op& operation) const {
+    check_mpi_result(MPI_Exscan(MPI_IN_PLACE, data.data(), count,
+                                data_type.native(),
+                                detail::native_op(operation), native()));
+  }
+
+  // In-place exclusive scan - builtin datatype with count
+  template <typename T, size_t Extent, reduction_op Op>
+  void exscan(std::span<T, Extent> data, const Op& operation) const {
+    exscan(data, as_weak_dtype<T>(), static_cast<int>(data.size()),
+           operation);
+  }
+
+  // Reduce_scatter_block - custom datatype with count per rank
+  template <typename T, size_t SendExtent, size_t RecvExtent, reduction_op Op>
+  void reduce_scatter_block(std::span<const T, SendExtent> send_data,
+                            std::span<T, RecvExtent> recv_data,
+                            const weak_dtype& data_type,
+                            int count,
+                            const Op& operation) const {
+    check_mpi_result(MPI_Reduce_scatter_block(
+        send_data.data(), recv_data.data(), count, data_type.native(),
+        detail::native_op(operation), native()));
+  }
+
+  // Reduce_scatter_block - builtin datatype, recv_data.size() per rank
+  template <typename T, size_t SendExtent, size_t RecvExtent, reduction_op Op>
+  void reduce_scatter_block(std::span<const T, SendExtent> send_data,
+                            std::span<T, RecvExtent> recv_data,
+                            const Op& operation) const {
+    assert(send_data.size() == recv_data.size() * size_);
+    reduce_scatter_block(send_data, recv_data, as_weak_dtype<T>(),
+                         static_cast<int>(recv_data.size()), operation);
+  }
+
+  // Reduce_scatter - builtin datatype, recv_counts[i] elements to rank i
+  template <typename T, size_t SendExtent, size_t RecvExtent, reduction_op Op>
+  void reduce_scatter(std::span<const T, SendExtent> send_data,
+                      std::span<T, RecvExtent> recv_data,
+                      std::span<const int> recv_counts,
+                      const Op& operation) const {
+    assert(recv_counts.size() == size_);
+    assert(recv_data.size()
+           >= static_cast<size_t>(recv_counts[static_cast<size_t>(rank_)]));
+    check_mpi_result(MPI_Reduce_scatter(
+        send_data.data(), recv_data.data(), recv_counts.data(),
+        as_builtin_datatype<T>(), detail::native_op(operation), native()));
+  }
+
+  // Single value reductions
+  template <typename T, reduction_op Op>
+  [[nodiscard]]
+  auto allreduce(const T& value, const Op& operation) const -> T
+    requires(!detail::is_std_span<T>)
+  {
+    T result{};
+    allreduce(std::span<const T, 1>(&value, 1), std::span<T, 1>(&result, 1),
+              operation);
+    return result;
+  }
+
+  // The returned value is only significant at root
+  template <typename T, reduction_op Op>
+  [[nodiscard]]
+  auto reduce(const T& value, const Op& operation, int root = 0) const -> T
+    requires(!detail::is_std_span<T>)
+  {
+    T result{};
+    reduce(std::span<const T, 1>(&value, 1), std::span<T, 1>(&result, 1),
+           operation, root);
+    return result;
+  }
+
+  template <typename T, reduction_op Op>
+  [[nodiscard]]
+  auto scan(const T& value, const Op& operation) const -> T
+    requires(!detail::is_std_span<T>)
+  {
+    T result{};
+    scan(std::span<const T, 1>(&value, 1), std::span<T, 1>(&result, 1),
+         operation);
+    return result;
+  }
+
+  // Returns a value-initialized T at rank 0
+  template <typename T, reduction_op Op>
+  [[nodiscard]]
+  auto exscan(const T& value, const Op& operation) const -> T
+    requires(!detail::is_std_span<T>)
+  {
+    T result{};
+    exscan(std::span<const T, 1>(&value, 1), std::span<T, 1>(&result, 1),
+           operation);
+    return rank_ == 0 ? T{} : result;
+  }
+
+  // Broadcast - custom datatype with count
+  template <typename T, size_t Extent>
+  void bcast(std::span<T, Extent> data,
+             const weak_dtype& data_type,
+             int count,
+             int root = 0) const {
+    check_mpi_result(
+        MPI_Bcast(data.data(), count, data_type.native(), root, native()));
+  }
+
+  // Broadcast - builtin datatype with count
+  template <typename T, size_t Extent>
+  void bcast(std::span<T, Extent> data, int root = 0) const {
+    bcast(data, as_weak_dtype<T>(), static_cast<int>(data.size()), root);
+  }
+
+  // Gather - custom datatype with count per rank
+  // recv_data is only significant at root
+  template <typename T, size_t SendExtent, size_t RecvExtent>
+  void gather(std::span<const T, SendExtent> send_data,
+              std::span<T, RecvExtent> recv_data,
+              const weak_dtype& data_type,
+              int count,
+              int root = 0) const {
+    check_mpi_result(MPI_Gather(send_data.data(), count, data_type.native(),
+                                recv_data.data(), count, data_type.native(),
+                                root, native()));
+  }
+
+  // Gather - builtin datatype with count per rank
+  template <typename T, size_t SendExtent, size_t RecvExtent>
+  void gather(std::span<const T, SendExtent> send_data,
+              std::span<T, RecvExtent> recv_data,
+              int root = 0) const {
+    gather(send_data, recv_data, as_weak_dtype<T>(),
+           static_cast<int>(send_data.size()), root);
+  }
+
+  // Gatherv - builtin datatype with explicit displacements
+  template <typename T, size_t SendExtent, size_t RecvExtent>
+  void gatherv(std::span<const T, SendExtent> send_data,
+               std::span<T, RecvExtent> recv_data,
+               std::span<const int> recv_counts,
+               std::span<const int> displs,
+               int root = 0) const {
+    check_mpi_result(MPI_Gatherv(
+        send_data.data(), static_cast<int>(send_data.size()),
+        as_builtin_datatype<T>(), recv_data.data(), recv_counts.data(),
+        displs.data(), as_builtin_datatype<T>(), root, native()));
+  }
+
+  // Gatherv - builtin datatype, contributions packed in rank order
+  // recv_counts and recv_data are only significant at root
+  template <typename T, size_t SendExtent, size_t RecvExtent>
+  void gatherv(std::span<const T, SendExtent> send_data,
+               std::span<T, RecvExtent> recv_data,
+               std::span<const int> recv_counts,
+               int root = 0) const {
+    if (rank_ == root) {
+      gatherv(send_data, recv_data, recv_counts, displacements(recv_counts),
+              root);
+    } else {
+      gatherv(send_data, recv_data, recv_counts, std::span<const int>{},
+              root);
+    }
+  }
+
+  // Allgather - custom datatype with count per rank
+  template <typename T, size_t SendExtent, size_t RecvExtent>
+  void allgather(std::span<const T, SendExtent> send_data,
+                 std::span<T, RecvExtent> recv_data,
+                 const weak_dtype& data_type,
+                 int count) const {
+    check_mpi_result(MPI_Allgather(send_data.data(), count, data_type.native(),
+                                   recv_data.data(), count, data_type.native(),
+                                   native()));
+  }
+
+  // Allgather - builtin datatype with count per rank
+  template <typename T, size_t SendExtent, size_t RecvExtent>
+  void allgather(std::span<const T, SendExtent> send_data,
+                 std::span<T, RecvExtent> recv_data) const {
+    allgather(send_data, recv_data, as_weak_dtype<T>(),
+              static_cast<int>(send_data.size()));
+  }
+
+  // Allgatherv - builtin datatype with explicit displacements
+  template <typename T, size_t SendExtent, size_t RecvExtent>
+  void allgatherv(std::span<const T, SendExtent> send_data,
+                  std::span<T, RecvExtent> recv_data,
+                  std::span<const int> recv_counts,
+                  std::span<const int> displs) const {
+    check_mpi_result(MPI_Allgatherv(
+        send_data.data(), static_cast<int>(send_data.size()),
+        as_builtin_datatype<T>(), recv_data.data(), recv_counts.data(),
+        displs.data(), as_builtin_datatype<T>(), native()));
+  }
+
+  // Allgatherv - builtin datatype, contributions packed in rank order
+  template <typename T, size_t SendExtent, size_t RecvExtent>
+  void allgatherv(std::span<const T, SendExtent> send_data,
+                  std::span<T, RecvExtent> recv_data,
+                  std::span<const int> recv_counts) const {
+    allgatherv(send_data, recv_data, recv_counts, displacements(recv_counts));
+  }
+
+  // Allgatherv - exchanges the counts first and returns every contribution
+  template <typename T, size_t Extent>
+  [[nodiscard]]
+  auto allgatherv(std::span<const T, Extent> send_data) const -> gathered<T> {
+    auto result = gathered<T>{};
+    result.counts = allgather(static_cast<int>(send_data.size()));
+    result.displs.resize(result.counts.size());
+    std::exclusive_scan(result.counts.begin(), result.counts.end(),
+                        result.displs.begin(), 0);
+    result.values.resize(static_cast<std::size_t>(
+        result.displs.empty() ? 0
+                              : result.displs.back() + result.counts.back()));
+    allgatherv(send_data, std::span<T>{result.values},
+               std::span<const int>{result.counts},
+               std::span<const int>{result.displs});
+    return result;
+  }
+
+  // Scatter - custom datatype with count per rank
+  // send_data is only significant at root
+  template <typename T, size_t SendExtent, size_t RecvExtent>
+  void scatter(std::span<const T, SendExtent> send_data,
+               std::span<T, RecvExtent> recv_data,
+               const weak_dtype& data_type,
+               int count,
+               int root = 0) const {
+    check_mpi_result(MPI_Scatter(send_data.data(), count, data_type.native(),
+                                 recv_data.data(), count, data_type.native(),
+                                 root, native()));
+  }
+
+  // Scatter - builtin datatype with count per rank
+  template <typename T, size_t SendExtent, size_t RecvExtent>
+  void scatter(std::span<const T, SendExtent> send_data,
+               std::span<T, RecvExtent> recv_data,
+               int root = 0) const {
+    scatter(send_data, recv_data, as_weak_dtype<T>(),
+            static_cast<int>(recv_data.size()), root);
+  }
+
+  // Scatterv - builtin datatype with explicit displacements
+  template <typename T, size_t SendExtent, size_t RecvExtent>
+  void scatterv(std::span<const T, SendExtent> send_data,
+                std::span<const int> send_counts,
+                std::span<const int> displs,
+                std::span<T, RecvExtent> recv_data,
+                int root = 0) const {
+    check_mpi_result(MPI_Scatterv(
+        send_data.data(), send_counts.data(), displs.data(),
+        as_builtin_datatype<T>(), recv_data.data(),
+        static_cast<int>(recv_data.size()), as_builtin_datatype<T>(), root,
+        native()));
+  }
+
+  // Scatterv - builtin datatype, chunks packed in rank order
+  // send_data and send_counts are only significant at root
+  template <typename T, size_t SendExtent, size_t RecvExtent>
+  void scatterv(std::span<const T, SendExtent> send_data,
+                std::span<const int> send_counts,
+                std::span<T, RecvExtent> recv_data,
+                int root = 0) const {
+    if (rank_ == root) {
+      scatterv(send_data, send_counts, displacements(send_counts), recv_data,
+               root);
+    } else {
+      scatterv(send_data, send_counts, std::span<const int>{}, recv_data,
+               root);
+    }
+  }
+
+  // Alltoall - custom datatype with count per rank
+  template <typename T, size_t SendExtent, size_t RecvExtent>
+  void alltoall(std::span<const T, SendExtent> send_data,
+                std::span<T, RecvExtent> recv_data,
+                const weak_dtype& data_type,
+                int count) const {
+    check_mpi_result(MPI_Alltoall(send_data.data(), count, data_type.native(),
+                                  recv_data.data(), count, data_type.native(),
+                                  native()));
+  }
+
+  // Alltoall - builtin datatype, send_data split evenly across ranks
+  template <typename T, size_t SendExtent, size_t RecvExtent>
+  void alltoall(std::span<const T, SendExtent> send_data,
+                std::span<T, RecvExtent> recv_data) const {
+    assert(send_data.size() % size_ == 0);
+    alltoall(send_data, recv_data, as_weak_dtype<T>(),
+             static_cast<int>(send_data.size() / size_));
+  }
+
+  // Alltoallv - builtin datatype with explicit counts and displacements
+  template <typename T, size_t SendExtent, size_t RecvExtent>
+  void alltoallv(std::span<const T, SendExtent> send_data,
+                 std::span<const int> send_counts,
+                 std::span<const int> send_displs,
+                 std::span<T, RecvExtent> recv_data,
+                 std::span<const int> recv_counts,
+                 std::span<const int> recv_displs) const {
+    assert(send_counts.size() == size_ && send_displs.size() == size_);
+    assert(recv_counts.size() == size_ && recv_displs.size() == size_);
+    check_mpi_result(MPI_Alltoallv(
+        send_data.data(), send_counts.data(), send_displs.data(),
+        as_builtin_datatype<T>(), recv_data.data(), recv_counts.data(),
+        recv_displs.data(), as_builtin_datatype<T>(), native()));
+  }
+
+  // Alltoallw - per-rank datatypes, displacements in bytes
+  void alltoallw(const void* send_data,
+                 std::span<const int> send_counts,
+                 std::span<const int> send_displs,
+                 std::span<const MPI_Datatype> send_types,
+                 void* recv_data,
+                 std::span<const int> recv_counts,
+                 std::span<const int> recv_displs,
+                 std::span<const MPI_Datatype> recv_types) const {
+    assert(send_counts.size() == size_ && send_displs.size() == size_
+           && send_types.size() == size_);
+    assert(recv_counts.size() == size_ && recv_displs.size() == size_
+           && recv_types.size() == size_);
+    check_mpi_result(MPI_Alltoallw(
+        send_data, send_counts.data(), send_displs.data(), send_types.data(),
+        recv_data, recv_counts.data(), recv_displs.data(), recv_types.data(),
+        native()));
+  }
+
+  // Single value collectives
+  template <typename T>
+  void bcast(T& value, int root = 0) const
+    requires(!detail::is_std_span<T>)
+  {
+    bcast(std::span<T, 1>(&value, 1), root);
+  }
+
+  // The returned vector is empty except at root
+  template <typename T>
+  [[nodiscard]]
+  auto gather(const T& value, int root = 0) const -> std::vector<T>
+    requires(!detail::is_std_span<T>)
+  {
+    auto result = std::vector<T>(rank_ == root ? size_ : 0);
+    gather(std::span<const T, 1>(&value, 1), std::span<T>{result}, root);
+    return result;
+  }
+
+  template <typename T>
+  [[nodiscard]]
+  auto allgather(const T& value) const -> std::vector<T>
+    requires(!detail::is_std_span<T>)
+  {
+    auto result = std::vector<T>(size_);
+    allgather(std::span<const T, 1>(&value, 1), std::span<T>{result});
+    return result;
+  }
+
+  // Nonblocking collectives
+  // Buffers must stay valid until the returned request completes; count
+  // and displacement arrays are copied into the request.
+  [[nodiscard]]
+  auto ibarrier() const -> request {
+    MPI_Request req = MPI_REQUEST_NULL;
+    check_mpi_result(MPI_Ibarrier(native(), &req));
+    return request{req};
+  }
+
+  template <typename T, size_t Extent>
+  [[nodiscard]]
+  auto ibcast(std::span<T, Extent> data,
+              const weak_dtype& data_type,
+              int count,
+              int root = 0) const -> request {
+    MPI_Request req = MPI_REQUEST_NULL;
+    check_mpi_result(MPI_Ibcast(data.data(), count, data_type.native(), root,
+                                native(), &req));
+    return request{req};
+  }
+
+  template <typename T, size_t Extent>
+  [[nodiscard]]
+  auto ibcast(std::span<T, Extent> data, int root = 0) const -> request {
+    return ibcast(data, as_weak_dtype<T>(), static_cast<int>(data.size()),
+                  root);
+  }
+
+  template <typename T, size_t SendExtent, size_t RecvExtent, reduction_op Op>
+  [[nodiscard]]
+  auto iallreduce(std::span<const T, SendExtent> send_data,
+                  std::span<T, RecvExtent> recv_data,
+                  const weak_dtype& data_type,
+                  int count,
+                  const Op& operation) const -> request {
+    MPI_Request req = MPI_REQUEST_NULL;
+    check_mpi_result(MPI_Iallreduce(send_data.data(), recv_data.data(), count,
+                                    data_type.native(),
+                                    detail::native_op(operation), native(),
+                                    &req));
+    return request{req};
+  }
+
+  template <typename T, size_t SendExtent, size_t RecvExtent, reduction_op Op>
+  [[nodiscard]]
+  auto iallreduce(std::span<const T, SendExtent> send_data,
+                  std::span<T, RecvExtent> recv_data,
+                  const Op& operation) const -> request {
+    return iallreduce(send_data, recv_data, as_weak_dtype<T>(),
+                      static_cast<int>(send_data.size()), operation);
+  }
+
+  template <typename T, size_t Extent, reduction_op Op>
+  [[nodiscard]]
+  auto iallreduce(std::span<T, Extent> data,
+                  const weak_dtype& data_type,
+                  int count,
+                  const Op& operation) const -> request {
+    MPI_Request req = MPI_REQUEST_NULL;
+    check_mpi_result(MPI_Iallreduce(MPI_IN_PLACE, data.data(), count,
+                                    data_type.native(),
+                                    detail::native_op(operation), native(),
+                                    &req));
+    return request{req};
+  }
+
+  template <typename T, size_t Extent, reduction_op Op>
+  [[nodiscard]]
+  auto iallreduce(std::span<T, Extent> data, const Op& operation) const
+      -> request {
+    return iallreduce(data, as_weak_dtype<T>(), static_cast<int>(data.size()),
+                      operation);
+  }
+
+  template <typename T, size_t SendExtent, size_t RecvExtent, reduction_op Op>
+  [[nodiscard]]
+  auto ireduce(std::span<const T, SendExtent> send_data,
+               std::span<T, RecvExtent> recv_data,
+               const weak_dtype& data_type,
+               int count,
+               const Op& operation,
+               int root = 0) const -> request {
+    MPI_Request req = MPI_REQUEST_NULL;
+    check_mpi_result(MPI_Ireduce(send_data.data(), recv_data.data(), count,
+                                 data_type.native(),
+                                 detail::native_op(operation), root, native(),
+                                 &req));
+    return request{req};
+  }
+
+  template <typename T, size_t SendExtent, size_t RecvExtent, reduction_op Op>
+  [[nodiscard]]
+  auto ireduce(std::span<const T, SendExtent> send_data,
+               std::span<T, RecvExtent> recv_data,
+               const Op& operation,
+               int root = 0) const -> request {
+    return ireduce(send_data, recv_data, as_weak_dtype<T>(),
+                   static_cast<int>(send_data.size()), operation, root);
+  }
+
+  template <typename T, size_t SendExtent, size_t RecvExtent, reduction_op Op>
+  [[nodiscard]]
+  auto iscan(std::span<const T, SendExtent> send_data,
+             std::span<T, RecvExtent> recv_data,
+             const weak_dtype& data_type,
+             int count,
+             const Op& operation) const -> request {
+    MPI_Request req = MPI_REQUEST_NULL;
+    check_mpi_result(MPI_Iscan(send_data.data(), recv_data.data(), count,
+                               data_type.native(),
+                               detail::native_op(operation), native(), &req));
+    return request{req};
+  }
+
+  template <typename T, size_t SendExtent, size_t RecvExtent, reduction_op Op>
+  [[nodiscard]]
+  auto iscan(std::span<const T, SendExtent> send_data,
+             std::span<T, RecvExtent> recv_data,
+             const Op& operation) const -> request {
+    return iscan(send_data, recv_data, as_weak_dtype<T>(),
+                 static_cast<int>(send_data.size()), operation);
+  }
+
+  // recv_data is left undefined at rank 0
+  template <typename T, size_t SendExtent, size_t RecvExtent, reduction_op Op>
+  [[nodiscard]]
+  auto iexscan(std::span<const T, SendExtent> send_data,
+               std::span<T, RecvExtent> recv_data,
+               const weak_dtype& data_type,
+               int count,
+               const Op& operation) const -> request {
+    MPI_Request req = MPI_REQUEST_NULL;
+    check_mpi_result(MPI_Iexscan(send_data.data(), recv_data.data(), count,
+                                 data_type.native(),
+                                 detail::native_op(operation), native(),
+                                 &req));
+    return request{req};
+  }
+
+  template <typename T, size_t SendExtent, size_t RecvExtent, reduction_op Op>
+  [[nodiscard]]
+  auto iexscan(std::span<const T, SendExtent> send_data,
+               std::span<T, RecvExtent> recv_data,
+               const Op& operation) const -> request {
+    return iexscan(send_data, recv_data, as_weak_dtype<T>(),
+                   static_cast<int>(send_data.size()), operation);
+  }
+
+  // count elements of data_type are sent by every rank
+  template <typename T, size_t SendExtent, size_t RecvExtent>
+  [[nodiscard]]
+  auto igather(std::span<const T, SendExtent> send_data,
+               std::span<T, RecvExtent> recv_data,
+               const weak_dtype& data_type,
+               int count,
+               int root = 0) const -> request {
+    MPI_Request req = MPI_REQUEST_NULL;
+    check_mpi_result(MPI_Igather(send_data.data(), count, data_type.native(),
+                                 recv_data.data(), count, data_type.native(),
+                                 root, native(), &req));
+    return request{req};
+  }
+
+  template <typename T, size_t SendExtent, size_t RecvExtent>
+  [[nodiscard]]
+  auto igather(std::span<const T, SendExtent> send_data,
+               std::span<T, RecvExtent> recv_data,
+               int root = 0) const -> request {
+    return igather(send_data, recv_data, as_weak_dtype<T>(),
+                   static_cast<int>(send_data.size()), root);
+  }
+
+  // recv_counts and recv_data are only significant at root
+  template <typename T, size_t SendExtent, size_t RecvExtent>
+  [[nodiscard]]
+  auto igatherv(std::span<const T, SendExtent> send_data,
+                std::span<T, RecvExtent> recv_data,
+                std::span<const int> recv_counts,
+                int root = 0) const -> request {
+    auto args = rank_ == root ? counts_and_displs(recv_counts)
+                              : std::vector<int>{};
+    auto const* counts = args.data();
+    auto const* displs = args.empty() ? nullptr : args.data() + size_;
+    MPI_Request req = MPI_REQUEST_NULL;
+    check_mpi_result(MPI_Igatherv(
+        send_data.data(), static_cast<int>(send_data.size()),
+        as_builtin_datatype<T>(), recv_data.data(), counts, displs,
+        as_builtin_datatype<T>(), root, native(), &req));
+    return request{req, std::move(args)};
+  }
+
+  template <typename T, size_t SendExtent, size_t RecvExtent>
+  [[nodiscard]]
+  auto iallgather(std::span<const T, SendExtent> send_data,
+                  std::span<T, RecvExtent> recv_data) const -> request {
+    MPI_Request req = MPI_REQUEST_NULL;
+    check_mpi_result(MPI_Iallgather(
+        send_data.data(), static_cast<int>(send_data.size()),
+        as_builtin_datatype<T>(), recv_data.data(),
+        static_cast<int>(send_data.size()), as_builtin_datatype<T>(), native(),
+        &req));
+    return request{req};
+  }
+
+  template <typename T, size_t SendExtent, size_t RecvExtent>
+  [[nodiscard]]
+  auto iallgatherv(std::span<const T, SendExtent> send_data,
+                   std::span<T, RecvExtent> recv_data,
+                   std::span<const int> recv_counts) const -> request {
+    auto args = counts_and_displs(recv_counts);
+    MPI_Request req = MPI_REQUEST_NULL;
+    check_mpi_result(MPI_Iallgatherv(
+        send_data.data(), static_cast<int>(send_data.size()),
+        as_builtin_datatype<T>(), recv_data.data(), args.data(),
+        args.data() + size_, as_builtin_datatype<T>(), native(), &req));
+    return request{req, std::move(args)};
+  }
+
+  template <typename T, size_t SendExtent, size_t RecvExtent>
+  [[nodiscard]]
+  auto iscatter(std::span<const T, SendExtent> send_data,
+                std::span<T, RecvExtent> recv_data,
+                int root = 0) const -> request {
+    MPI_Request req = MPI_REQUEST_NULL;
+    check_mpi_result(MPI_Iscatter(
+        send_data.data(), static_cast<int>(recv_data.size()),
+        as_builtin_datatype<T>(), recv_data.data(),
+        static_cast<int>(recv_data.size()), as_builtin_datatype<T>(), root,
+        native(), &req));
+    return request{req};
+  }
+
+  // send_data and send_counts are only significant at root
+  template <typename T, size_t SendExtent, size_t RecvExtent>
+  [[nodiscard]]
+  auto iscatterv(std::span<const T, SendExtent> send_data,
+                 std::span<const int> send_counts,
+                 std::span<T, RecvExtent> recv_data,
+                 int root = 0) const -> request {
+    auto args = rank_ == root ? counts_and_displs(send_counts)
+                              : std::vector<int>{};
+    auto const* counts = args.data();
+    auto const* displs = args.empty() ? nullptr : args.data() + size_;
+    MPI_Request req = MPI_REQUEST_NULL;
+    check_mpi_result(MPI_Iscatterv(
+        send_data.data(), counts, displs, as_builtin_datatype<T>(),
+        recv_data.data(), static_cast<int>(recv_data.size()),
+        as_builtin_datatype<T>(), root, native(), &req));
+    return request{req, std::move(args)};
+  }
+
+  template <typename T, size_t SendExtent, size_t RecvExtent>
+  [[nodiscard]]
+  auto ialltoall(std::span<const T, SendExtent> send_data,
+                 std::span<T, RecvExtent> recv_data) const -> request {
+    assert(send_data.size() % size_ == 0);
+    auto const count = static_cast<int>(send_data.size() / size_);
+    MPI_Request req = MPI_REQUEST_NULL;
+    check_mpi_result(MPI_Ialltoall(send_data.data(), count,
+                                   as_builtin_datatype<T>(), recv_data.data(),
+                                   count, as_builtin_datatype<T>(), native(),
+                                   &req));
+    return request{req};
+  }
+
+  template <typename T, size_t SendExtent, size_t RecvExtent>
+  [[nodiscard]]
+  auto ialltoallv(std::span<const T, SendExtent> send_data,
+                  std::span<const int> send_counts,
+                  std::span<const int> send_displs,
+                  std::span<T, RecvExtent> recv_data,
+                  std::span<const int> recv_counts,
+                  std::span<const int> recv_displs) const -> request {
+    assert(send_counts.size() == size_ && send_displs.size() == size_);
+    assert(recv_counts.size() == size_ && recv_displs.size() == size_);
+    auto args = std::vector<int>{};
+    args.reserve(size_ * 4);
+    for (auto const part :
+         {send_counts, send_displs, recv_counts, recv_displs}) {
+      args.insert(args.end(), part.begin(), part.end());
+    }
+    auto const* a = args.data();
+    MPI_Request req = MPI_REQUEST_NULL;
+    check_mpi_result(MPI_Ialltoallv(
+        send_data.data(), a, a + size_, as_builtin_datatype<T>(),
+        recv_data.data(), a + (2 * size_), a + (3 * size_),
+        as_builtin_datatype<T>(), native(), &req));
+    return request{req, std::move(args)};
+  }
+
+  // Persistent collectives
+  // Bound to their buffers once and started repeatedly; see
+  // persistent_collective for the pre-MPI-4 fallback.
+  template <typename T, size_t SendExtent, size_t RecvExtent, reduction_op Op>
+  [[nodiscard]]
+  auto allreduce_init(std::span<const T, SendExtent> send_data,
+                      std::span<T, RecvExtent> recv_data,
+                      const Op& operation) const -> persistent_collective {
+    return make_allreduce_init<T>(send_data.data(), recv_data.data(),
+                                  static_cast<int>(send_data.size()),
+                                  detail::native_op(operation));
+  }
+
+  template <typename T, size_t Extent, reduction_op Op>
+  [[nodiscard]]
+  auto allreduce_init(std::span<T, Extent> data, const Op& operation) const
+      -> persistent_collective {
+    return make_allreduce_init<T>(MPI_IN_PLACE, data.data(),
+                                  static_cast<int>(data.size()),
+                                  detail::native_op(operation));
+  }
+
+  template <typename T, size_t Extent>
+  [[nodiscard]]
+  auto bcast_init(std::span<T, Extent> data, int root = 0) const
+      -> persistent_collective {
+    auto const count = static_cast<int>(data.size());
+#if defined(CXXMPI_HAS_PERSISTENT_COLLECTIVES)
+    MPI_Request req = MPI_REQUEST_NULL;
+    check_mpi_result(MPI_Bcast_init(data.data(), count,
+                                    as_builtin_datatype<T>(), root, native(),
+                                    MPI_INFO_NULL, &req));
+    return persistent_collective{req, {}};
+#else
+    return persistent_collective{
+        [buf = data.data(), count, root,
+         mpi_comm = native()](MPI_Request* req) {
+          return MPI_Ibcast(buf, count, as_builtin_datatype<T>(), root,
+                            mpi_comm, req);
+        },
+        {}};
+#endif
+  }
+
+  template <typename T, size_t SendExtent, size_t RecvExtent>
+  [[nodiscard]]
+  auto alltoallv_init(std::span<const T, SendExtent> send_data,
+                      std::span<const int> send_counts,
+                      std::span<const int> send_displs,
+                      std::span<T, RecvExtent> recv_data,
+                      std::span<const int> recv_counts,
+                      std::span<const int> recv_displs) const
+      -> persistent_collective {
+    assert(send_counts.size() == size_ && send_displs.size() == size_);
+    assert(recv_counts.size() == size_ && recv_displs.size() == size_);
+    auto args = std::vector<int>{};
+    args.reserve(size_ * 4);
+    for (auto const part :
+         {send_counts, send_displs, recv_counts, recv_displs}) {
+      args.insert(args.end(), part.begin(), part.end());
+    }
+    auto const* a = args.data();
+#if defined(CXXMPI_HAS_PERSISTENT_COLLECTIVES)
+    MPI_Request req = MPI_REQUEST_NULL;
+    check_mpi_result(MPI_Alltoallv_init(
+        send_data.data(), a, a + size_, as_builtin_datatype<T>(),
+        recv_data.data(), a + (2 * size_), a + (3 * size_),
+        as_builtin_datatype<T>(), native(), MPI_INFO_NULL, &req));
+    return persistent_collective{req, std::move(args)};
+#else
+    return persistent_collective{
+        [sbuf = send_data.data(), rbuf = recv_data.data(), a, n = size_,
+         mpi_comm = native()](MPI_Request* req) {
+          return MPI_Ialltoallv(sbuf, a, a + n, as_builtin_datatype<T>(), rbuf,
+                                a + (2 * n), a + (3 * n),
+                                as_builtin_datatype<T>(), mpi_comm, req);
+        },
+        std::move(args)};
+#endif
+  }
+
  private:
   template <typename BaseHandler>
   auto create_split_comm(const basic_comm<BaseHandler>& base,
@@ -308,6 +1474,68 @@ class basic_comm {
     return comm_handle{weak_comm_handle{new_comm}};
   }
 
+  template <typename T>
+  [[nodiscard]]
+  auto make_allreduce_init(const void* send_data,
+                           T* recv_data,
+                           int count,
+                           MPI_Op mpi_op) const -> persistent_collective {
+#if defined(CXXMPI_HAS_PERSISTENT_COLLECTIVES)
+    MPI_Request req = MPI_REQUEST_NULL;
+    check_mpi_result(MPI_Allreduce_init(send_data, recv_data, count,
+                                        as_builtin_datatype<T>(), mpi_op,
+                                        native(), MPI_INFO_NULL, &req));
+    return persistent_collective{req, {}};
+#else
+    return persistent_collective{
+        [send_data, recv_data, count, mpi_op,
+         mpi_comm = native()](MPI_Request* req) {
+          return MPI_Iallreduce(send_data, recv_data, count,
+                                as_builtin_datatype<T>(), mpi_op, mpi_comm,
+                                req);
+        },
+        {}};
+#endif
+  }
+
+  // Element count of a probed message; a size that is not a whole number
+  // of T is a type mismatch
+  template <typename T>
+  [[nodiscard]]
+  static auto matched_count(const status& st) -> size_t {
+    auto const count = st.count<T>();
+    if (count == MPI_UNDEFINED) {
+      throw mpi_error{MPI_ERR_TYPE};
+    }
+    return static_cast<size_t>(count);
+  }
+
+  // Counts followed by their exclusive prefix sum, owned by a request
+  [[nodiscard]]
+  auto counts_and_displs(std::span<const int> counts) const
+      -> std::vector<int> {
+    assert(counts.size() == size_);
+    auto args = std::vector<int>(counts.size() * 2);
+    std::ranges::copy(counts, args.begin());
+    std::exclusive_scan(counts.begin(), counts.end(),
+                        args.begin() + static_cast<std::ptrdiff_t>(size_), 0);
+    return args;
+  }
+
+  // Exclusive prefix sum of counts into a displacement buffer reused
+  // across calls. The buffer is per thread, so concurrent collectives on
+  // one communicator (e.g. comm_world() under MPI_THREAD_MULTIPLE) do not
+  // share it; the span is valid until the thread's next call.
+  [[nodiscard]]
+  auto displacements(std::span<const int> counts) const
+      -> std::span<const int> {
+    assert(counts.size() == size_);
+    thread_local std::vector<int> displs;
+    displs.resize(counts.size());
+    std::exclusive_scan(counts.begin(), counts.end(), displs.begin(), 0);
+    return displs;
+  }
+
   auto do_get_rank() const -> int {
     int rank = MPI_PROC_NULL;
     check_mpi_result(MPI_Comm_rank(native(), &rank));
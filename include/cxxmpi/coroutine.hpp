@@ -0,0 +1,428 @@
+#pragma once
+
+#include <concepts>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <mpi.h>
+
+#include "cxxmpi/error.hpp"
+#include "cxxmpi/request.hpp"
+#include "cxxmpi/status.hpp"
+
+namespace cxxmpi {
+
+template <typename T = void>
+class task;
+
+namespace detail {
+
+class task_promise_base {
+ public:
+  struct final_awaiter {
+    [[nodiscard]]
+    auto await_ready() const noexcept -> bool {
+      return false;
+    }
+
+    // Symmetric transfer back to the awaiting coroutine, if any
+    template <typename Promise>
+    auto await_suspend(std::coroutine_handle<Promise> handle) const noexcept
+        -> std::coroutine_handle<> {
+      auto& promise = static_cast<task_promise_base&>(handle.promise());
+      if (promise.continuation_) {
+        return promise.continuation_;
+      }
+      return std::noop_coroutine();
+    }
+
+    void await_resume() const noexcept {}
+  };
+
+  auto initial_suspend() noexcept -> std::suspend_always { return {}; }
+
+  auto final_suspend() noexcept -> final_awaiter { return {}; }
+
+  void unhandled_exception() noexcept { exception_ = std::current_exception(); }
+
+  void set_continuation(std::coroutine_handle<> continuation) noexcept {
+    continuation_ = continuation;
+  }
+
+ protected:
+  void rethrow_if_failed() const {
+    if (exception_) {
+      std::rethrow_exception(exception_);
+    }
+  }
+
+ private:
+  std::coroutine_handle<> continuation_;
+  std::exception_ptr exception_;
+};
+
+template <typename T>
+class task_promise : public task_promise_base {
+  std::optional<T> value_;
+
+ public:
+  auto get_return_object() noexcept -> task<T>;
+
+  template <typename U>
+    requires std::convertible_to<U, T>
+  void return_value(U&& value) {
+    value_.emplace(std::forward<U>(value));
+  }
+
+  auto result() -> T {
+    rethrow_if_failed();
+    return std::move(*value_);
+  }
+};
+
+template <>
+class task_promise<void> : public task_promise_base {
+ public:
+  auto get_return_object() noexcept -> task<void>;
+
+  void return_void() noexcept {}
+
+  void result() const { rethrow_if_failed(); }
+};
+
+// Fire-and-forget frame used by scheduler::spawn; it frees itself on
+// completion
+struct detached_task {
+  struct promise_type {
+    auto get_return_object() noexcept -> detached_task { return {}; }
+    auto initial_suspend() noexcept -> std::suspend_never { return {}; }
+    auto final_suspend() noexcept -> std::suspend_never { return {}; }
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept { std::terminate(); }
+  };
+};
+
+}  // namespace detail
+
+// Lazily started coroutine. It runs when first co_awaited and resumes its
+// awaiter when it finishes; top-level tasks are handed to scheduler::spawn.
+template <typename T>
+class [[nodiscard]] task {
+ public:
+  using promise_type = detail::task_promise<T>;
+  using handle_type = std::coroutine_handle<promise_type>;
+
+  task() = default;
+
+  explicit task(handle_type handle) noexcept : handle_{handle} {}
+
+  task(const task&) = delete;
+  auto operator=(const task&) -> task& = delete;
+
+  task(task&& other) noexcept : handle_{std::exchange(other.handle_, {})} {}
+
+  auto operator=(task&& other) noexcept -> task& {
+    if (this != &other) {
+      if (handle_) {
+        handle_.destroy();
+      }
+      handle_ = std::exchange(other.handle_, {});
+    }
+    return *this;
+  }
+
+  ~task() {
+    if (handle_) {
+      handle_.destroy();
+    }
+  }
+
+  [[nodiscard]]
+  auto done() const noexcept -> bool {
+    return !handle_ || handle_.done();
+  }
+
+  auto operator co_await() && noexcept {
+    struct awaiter {
+      handle_type handle;
+
+      [[nodiscard]]
+      auto await_ready() const noexcept -> bool {
+        return !handle || handle.done();
+      }
+
+      auto await_suspend(std::coroutine_handle<> continuation) noexcept
+          -> std::coroutine_handle<> {
+        handle.promise().set_continuation(continuation);
+        return handle;
+      }
+
+      auto await_resume() -> T { return handle.promise().result(); }
+    };
+    return awaiter{handle_};
+  }
+
+ private:
+  handle_type handle_;
+};
+
+namespace detail {
+
+template <typename T>
+inline auto task_promise<T>::get_return_object() noexcept -> task<T> {
+  return task<T>{std::coroutine_handle<task_promise>::from_promise(*this)};
+}
+
+inline auto task_promise<void>::get_return_object() noexcept -> task<void> {
+  return task<void>{std::coroutine_handle<task_promise>::from_promise(*this)};
+}
+
+}  // namespace detail
+
+// Single-threaded driver for many concurrent communication flows. Suspended
+// operations are kept in one contiguous MPI_Request array that is completed
+// with a single MPI_Testsome/MPI_Waitsome per round, so the polling cost
+// does not grow with one loop per flow. Must not be destroyed while flows
+// are still suspended on it.
+class scheduler {
+ public:
+  class schedule_awaitable {
+    scheduler* sched_;
+
+   public:
+    explicit schedule_awaitable(scheduler& sched) noexcept : sched_{&sched} {}
+
+    [[nodiscard]]
+    auto await_ready() const noexcept -> bool {
+      return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) {
+      sched_->ready_.push_back(handle);
+    }
+
+    void await_resume() const noexcept {}
+  };
+
+  class request_awaitable {
+    scheduler* sched_;
+    request request_;
+    status status_;
+
+   public:
+    request_awaitable(scheduler& sched, request&& req) noexcept
+        : sched_{&sched}, request_{std::move(req)} {}
+
+    [[nodiscard]]
+    auto await_ready() const noexcept -> bool {
+      return !request_.active();
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) {
+      sched_->enqueue(request_.native(), status_.native(), handle);
+    }
+
+    // The scheduler completed the operation; drop the stale handle
+    auto await_resume() noexcept -> status {
+      request_.native() = MPI_REQUEST_NULL;
+      return status_;
+    }
+  };
+
+  template <typename T>
+  class future_awaitable {
+    scheduler* sched_;
+    future<T> future_;
+    status status_;
+
+   public:
+    future_awaitable(scheduler& sched, future<T>&& fut) noexcept
+        : sched_{&sched}, future_{std::move(fut)} {}
+
+    [[nodiscard]]
+    auto await_ready() const noexcept -> bool {
+      return !future_.valid();
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) {
+      sched_->enqueue(future_.native(), status_.native(), handle);
+    }
+
+    auto await_resume() -> T {
+      future_.native() = MPI_REQUEST_NULL;
+      return future_.get();
+    }
+  };
+
+  scheduler() = default;
+
+  scheduler(const scheduler&) = delete;
+  auto operator=(const scheduler&) -> scheduler& = delete;
+  scheduler(scheduler&&) = delete;
+  auto operator=(scheduler&&) -> scheduler& = delete;
+  ~scheduler() = default;
+
+  // Starts flow on the next round of run() or poll()
+  void spawn(task<> flow) {
+    ++active_;
+    run_detached(*this, std::move(flow));
+  }
+
+  // Reschedules the awaiting flow behind the ones already ready
+  [[nodiscard]]
+  auto schedule() noexcept -> schedule_awaitable {
+    return schedule_awaitable{*this};
+  }
+
+  // co_await sched.wait(comm.irecv(...)) suspends until completion and
+  // yields the status
+  [[nodiscard]]
+  auto wait(request&& req) noexcept -> request_awaitable {
+    return {*this, std::move(req)};
+  }
+
+  // co_await sched.wait(comm.irecv(std::move(buffer), ...)) yields the
+  // filled buffer
+  template <typename T>
+  [[nodiscard]]
+  auto wait(future<T>&& fut) noexcept -> future_awaitable<T> {
+    return {*this, std::move(fut)};
+  }
+
+  // Number of spawned flows that have not finished
+  [[nodiscard]]
+  auto active() const noexcept -> std::size_t {
+    return active_;
+  }
+
+  // Number of operations flows are suspended on
+  [[nodiscard]]
+  auto pending() const noexcept -> std::size_t {
+    return requests_.size();
+  }
+
+  // Resumes the ready flows and tests the pending operations once. Returns
+  // whether any flow is still unfinished.
+  auto poll() -> bool {
+    resume_ready();
+    progress(false);
+    resume_ready();
+    rethrow_if_failed();
+    return active_ > 0;
+  }
+
+  // Drives all flows to completion, blocking in MPI_Waitsome whenever no
+  // flow is ready. Rethrows the first exception escaping a flow.
+  void run() {
+    while (active_ > 0) {
+      resume_ready();
+      if (active_ == 0) {
+        break;
+      }
+      if (requests_.empty()) {
+        if (ready_.empty()) {
+          throw std::logic_error(
+              "flows are suspended on work not driven by this scheduler");
+        }
+        continue;
+      }
+      progress(ready_.empty());
+    }
+    rethrow_if_failed();
+  }
+
+ private:
+  struct waiter {
+    std::coroutine_handle<> handle;
+    MPI_Status* status;
+  };
+
+  std::vector<MPI_Request> requests_;
+  std::vector<waiter> waiters_;
+  std::vector<int> indices_;
+  std::vector<MPI_Status> statuses_;
+  std::deque<std::coroutine_handle<>> ready_;
+  std::size_t active_{0};
+  std::exception_ptr error_;
+
+  static auto run_detached(scheduler& sched, task<> flow)
+      -> detail::detached_task {
+    co_await sched.schedule();
+    try {
+      co_await std::move(flow);
+    } catch (...) {
+      if (!sched.error_) {
+        sched.error_ = std::current_exception();
+      }
+    }
+    --sched.active_;
+  }
+
+  void enqueue(MPI_Request req,
+               MPI_Status& st,
+               std::coroutine_handle<> handle) {
+    requests_.push_back(req);
+    waiters_.push_back({handle, &st});
+  }
+
+  // Flows made ready while resuming wait for the next round, so a flow that
+  // keeps yielding cannot starve the polling
+  void resume_ready() {
+    for (auto n = ready_.size(); n > 0 && !ready_.empty(); --n) {
+      auto handle = ready_.front();
+      ready_.pop_front();
+      handle.resume();
+    }
+  }
+
+  void progress(bool blocking) {
+    if (requests_.empty()) {
+      return;
+    }
+    auto const n = static_cast<int>(requests_.size());
+    indices_.resize(requests_.size());
+    statuses_.resize(requests_.size());
+    int outcount = 0;
+    if (blocking) {
+      check_mpi_result(MPI_Waitsome(n, requests_.data(), &outcount,
+                                    indices_.data(), statuses_.data()));
+    } else {
+      check_mpi_result(MPI_Testsome(n, requests_.data(), &outcount,
+                                    indices_.data(), statuses_.data()));
+    }
+    if (outcount == MPI_UNDEFINED || outcount == 0) {
+      return;
+    }
+
+    for (std::size_t i = 0; i < static_cast<std::size_t>(outcount); ++i) {
+      auto& w = waiters_[static_cast<std::size_t>(indices_[i])];
+      *w.status = statuses_[i];
+      ready_.push_back(std::exchange(w.handle, nullptr));
+    }
+
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < requests_.size(); ++i) {
+      if (waiters_[i].handle) {
+        requests_[kept] = requests_[i];
+        waiters_[kept] = waiters_[i];
+        ++kept;
+      }
+    }
+    requests_.resize(kept);
+    waiters_.resize(kept);
+  }
+
+  void rethrow_if_failed() {
+    if (error_) {
+      std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+  }
+};
+
+}  // namespace cxxmpi
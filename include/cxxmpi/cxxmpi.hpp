@@ -2,10 +2,23 @@
 
 #include <cxxmpi/cart_comm.hpp>
 #include <cxxmpi/comm.hpp>
+#include <cxxmpi/coroutine.hpp>
 #include <cxxmpi/dims.hpp>
+#include <cxxmpi/dist_graph_comm.hpp>
+#include <cxxmpi/distributed_unordered_map.hpp>
 #include <cxxmpi/dtype.hpp>
 #include <cxxmpi/error.hpp>
+#include <cxxmpi/exchange_plan.hpp>
 #include <cxxmpi/file.hpp>
+#include <cxxmpi/halo.hpp>
+#include <cxxmpi/message.hpp>
+#include <cxxmpi/neighbor_collectives.hpp>
+#include <cxxmpi/op.hpp>
+#include <cxxmpi/partitioned.hpp>
+#include <cxxmpi/persistent_channel.hpp>
+#include <cxxmpi/persistent_collective.hpp>
+#include <cxxmpi/progress_engine.hpp>
 #include <cxxmpi/request.hpp>
 #include <cxxmpi/status.hpp>
 #include <cxxmpi/universe.hpp>
+#include <cxxmpi/window.hpp>
@@ -1,11 +1,18 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <limits>
 #include <span>
 #include <stdexcept>
+#include <tuple>
 #include <vector>
 
 #include <mpi.h>
 
+#include "comm.hpp"
 #include "error.hpp"
 
 namespace cxxmpi {
@@ -41,4 +48,220 @@ inline auto create_dims(int nprocs, std::initializer_list<int> init_dims)
   return create_dims(nprocs, std::span{init_dims.begin(), init_dims.size()});
 }
 
+// Halo bytes one node exchanges with other nodes per exchange when a
+// global domain of cells is split over a process grid of dims and every
+// node owns a node_block of processes. Counts both faces of each dimension
+// the node block does not span, so it describes an interior node of a
+// periodic grid; edges and corners are neglected.
+[[nodiscard]]
+inline auto inter_node_halo_bytes(std::span<const int> domain,
+                                  std::span<const int> dims,
+                                  std::span<const int> node_block,
+                                  int ghost_width,
+                                  std::size_t element_size) -> std::size_t {
+  if (domain.size() != dims.size() || node_block.size() != dims.size()) {
+    throw std::invalid_argument(
+        "domain, dims and node_block must have the same size");
+  }
+  auto tile = [&](std::size_t d) {
+    auto const cells = (domain[d] + dims[d] - 1) / dims[d];
+    return static_cast<std::size_t>(cells) *
+           static_cast<std::size_t>(node_block[d]);
+  };
+  std::size_t cells = 0;
+  for (std::size_t d = 0; d < dims.size(); ++d) {
+    if (node_block[d] < dims[d]) {
+      std::size_t area = 1;
+      for (std::size_t e = 0; e < dims.size(); ++e) {
+        area *= e == d ? 1 : tile(e);
+      }
+      cells += 2 * area;
+    }
+  }
+  return cells * static_cast<std::size_t>(ghost_width) * element_size;
+}
+
+// Processes per shared-memory node of communicator, or 0 if the nodes hold
+// different numbers of processes. Collective over communicator.
+template <typename Handle>
+[[nodiscard]]
+auto processes_per_node(const basic_comm<Handle>& communicator) -> int {
+  auto const node = communicator.split_type(split_kind::shared);
+  auto const ppn = static_cast<int>(node.size());
+  std::array<int, 2> extremes = {ppn, -ppn};
+  communicator.allreduce(std::span{extremes}, std::ranges::min);
+  return extremes[0] == -extremes[1] ? ppn : 0;
+}
+
+namespace detail {
+
+struct node_block_choice {
+  std::vector<int> block;
+  std::size_t cost{std::numeric_limits<std::size_t>::max()};
+};
+
+// Tries every block extent of dimension d that divides both the grid and
+// the processes still to place
+inline void search_node_block(std::span<const int> domain,
+                              std::span<const int> dims,
+                              std::size_t d,
+                              int remaining,
+                              std::vector<int>& block,
+                              node_block_choice& best) {
+  if (d == dims.size()) {
+    if (remaining != 1) {
+      return;
+    }
+    auto const cost = inter_node_halo_bytes(domain, dims, block, 1, 1);
+    // Ties go to the more compact block
+    if (cost < best.cost
+        || (cost == best.cost
+            && std::ranges::max(block) < std::ranges::max(best.block))) {
+      best.cost = cost;
+      best.block = block;
+    }
+    return;
+  }
+  for (int b = 1; b <= dims[d] && b <= remaining; ++b) {
+    if (dims[d] % b == 0 && remaining % b == 0) {
+      block[d] = b;
+      search_node_block(domain, dims, d + 1, remaining / b, block, best);
+    }
+  }
+}
+
+// Node block of ppn processes that divides dims and sends the fewest halo
+// bytes to other nodes; the block is empty if none exists
+[[nodiscard]]
+inline auto best_node_block(std::span<const int> domain,
+                            std::span<const int> dims,
+                            int ppn) -> node_block_choice {
+  std::vector<int> block(dims.size(), 1);
+  node_block_choice best;
+  search_node_block(domain, dims, 0, ppn, block, best);
+  return best;
+}
+
+// Shape of the sub-grid owned by one node of ppn processes: it divides dims
+// and has the smallest surface towards other nodes. Empty if no such shape
+// exists.
+[[nodiscard]]
+inline auto node_block_shape(std::span<const int> dims, int ppn)
+    -> std::vector<int> {
+  return best_node_block(dims, dims, ppn).block;
+}
+
+struct grid_choice {
+  std::vector<int> dims;
+  // Node block the inter-node cost was computed for
+  std::vector<int> block;
+  std::size_t node_cost{std::numeric_limits<std::size_t>::max()};
+  std::size_t process_cost{std::numeric_limits<std::size_t>::max()};
+};
+
+// Tries every factorization of the processes still to place over the
+// dimensions from d on. Larger extents are tried first, so among equal
+// grids the non-increasing one MPI_Dims_create would return wins.
+inline void search_grid(std::span<const int> domain,
+                        std::size_t d,
+                        int remaining,
+                        int ppn,
+                        std::vector<int>& dims,
+                        grid_choice& best) {
+  if (d == dims.size()) {
+    if (remaining != 1) {
+      return;
+    }
+    auto const node = best_node_block(domain, dims, ppn);
+    if (node.block.empty()) {
+      return;
+    }
+    // Inter-node traffic first, then the halo of a single process, then
+    // the more compact grid
+    std::vector<int> single(dims.size(), 1);
+    auto const process_cost =
+        inter_node_halo_bytes(domain, dims, single, 1, 1);
+    auto const key =
+        std::tuple{node.cost, process_cost, std::ranges::max(dims)};
+    if (best.dims.empty()
+        || key < std::tuple{best.node_cost, best.process_cost,
+                            std::ranges::max(best.dims)}) {
+      best.dims = dims;
+      best.block = node.block;
+      best.node_cost = node.cost;
+      best.process_cost = process_cost;
+    }
+    return;
+  }
+  for (int n = remaining; n >= 1; --n) {
+    if (remaining % n == 0) {
+      dims[d] = n;
+      search_grid(domain, d + 1, remaining / n, ppn, dims, best);
+    }
+  }
+}
+
+// Grid of nprocs processes for domain, see create_dims(communicator, domain)
+[[nodiscard]]
+inline auto choose_grid(std::span<const int> domain, int nprocs, int ppn)
+    -> grid_choice {
+  std::vector<int> dims(domain.size());
+  grid_choice best;
+  search_grid(domain, 0, nprocs, ppn, dims, best);
+  return best;
+}
+
+// Row-major grid rank of local process local of node node when every node
+// owns a block of the grid and the nodes tile it in row-major order
+[[nodiscard]]
+inline auto node_block_rank(std::span<const int> dims,
+                            std::span<const int> block,
+                            int node,
+                            int local) noexcept -> int {
+  int rank = 0;
+  int stride = 1;
+  int node_stride = 1;
+  int local_stride = 1;
+  for (auto d = dims.size(); d-- > 0;) {
+    auto const nodes = dims[d] / block[d];
+    auto const coord = (node / node_stride % nodes) * block[d]
+                     + (local / local_stride % block[d]);
+    rank += coord * stride;
+    stride *= dims[d];
+    node_stride *= nodes;
+    local_stride *= block[d];
+  }
+  return rank;
+}
+
+}  // namespace detail
+
+// Node-aware variant: factors the processes of communicator into a grid
+// for a global domain of cells such that, with every node owning a compact
+// block of the grid, the fewest halo bytes cross nodes. Ties are broken by
+// the halo of a single process. If the nodes hold different numbers of
+// processes only the latter is minimized. Collective over communicator;
+// pass the grid and the same domain to the domain-aware cart_comm
+// constructor to get the node blocks the cost was computed for.
+template <typename Handle>
+[[nodiscard]]
+auto create_dims(const basic_comm<Handle>& communicator,
+                 std::span<const int> domain) -> std::vector<int> {
+  if (domain.empty()) {
+    throw std::invalid_argument("Domain cannot be empty");
+  }
+  auto const ppn = std::max(processes_per_node(communicator), 1);
+  return detail::choose_grid(domain, static_cast<int>(communicator.size()),
+                             ppn)
+      .dims;
+}
+
+template <typename Handle>
+[[nodiscard]]
+auto create_dims(const basic_comm<Handle>& communicator,
+                 std::initializer_list<int> domain) -> std::vector<int> {
+  return create_dims(communicator,
+                     std::span{domain.begin(), domain.size()});
+}
+
 }  // namespace cxxmpi
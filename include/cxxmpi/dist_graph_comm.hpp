@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <mpi.h>
+
+#include "comm.hpp"
+#include "error.hpp"
+#include "neighbor_collectives.hpp"
+
+namespace cxxmpi {
+
+// Communicator with a distributed graph topology. Every process names only
+// its own sources (processes it receives from) and destinations (processes
+// it sends to), which suits unstructured meshes whose neighborhoods are
+// known locally. The neighbor collectives exchange with exactly these
+// processes.
+template <typename Handle = comm_handle>
+class basic_dist_graph_comm
+    : public basic_comm<Handle>,
+      public neighbor_collectives<basic_dist_graph_comm<Handle>> {
+ public:
+  using handle_type = Handle;
+
+  constexpr basic_dist_graph_comm() noexcept = default;
+  constexpr basic_dist_graph_comm(const basic_dist_graph_comm& other) = delete;
+  constexpr basic_dist_graph_comm(basic_dist_graph_comm&& other) noexcept =
+      default;
+  constexpr auto operator=(const basic_dist_graph_comm& other)
+      -> basic_dist_graph_comm& = delete;
+  auto operator=(basic_dist_graph_comm&& other) noexcept
+      -> basic_dist_graph_comm& = default;
+  constexpr ~basic_dist_graph_comm() = default;
+
+  // weak_dist_graph_comm can be copyable / assignable
+  constexpr basic_dist_graph_comm(const basic_dist_graph_comm& other)
+    requires std::is_copy_constructible_v<Handle>
+      : basic_comm<Handle>{other} {}
+  constexpr auto operator=(const basic_dist_graph_comm& other)
+      -> basic_dist_graph_comm&
+    requires std::is_copy_assignable_v<Handle>
+  {
+    if (this != &other) {
+      basic_comm<Handle>::operator=(other);
+    }
+    return *this;
+  }
+
+  // dist_graph_comm to weak_dist_graph_comm conversion constructor
+  constexpr explicit basic_dist_graph_comm(
+      const basic_dist_graph_comm<comm_handle>& other)
+    requires std::same_as<Handle, weak_comm_handle>
+      : basic_comm<Handle>{other} {}
+
+  // Unweighted graph
+  template <typename BaseHandle>
+  basic_dist_graph_comm(const basic_comm<BaseHandle>& base,
+                        std::span<const int> sources,
+                        std::span<const int> destinations,
+                        bool reorder = false)
+      : basic_comm<Handle>{create_dist_graph_comm(
+            base, sources, MPI_UNWEIGHTED, destinations, MPI_UNWEIGHTED,
+            reorder)} {}
+
+  // Weighted graph; the weights hint at the communication volume per edge
+  template <typename BaseHandle>
+  basic_dist_graph_comm(const basic_comm<BaseHandle>& base,
+                        std::span<const int> sources,
+                        std::span<const int> source_weights,
+                        std::span<const int> destinations,
+                        std::span<const int> destination_weights,
+                        bool reorder = false)
+      : basic_comm<Handle>{create_dist_graph_comm(
+            base, sources, checked_weights(sources, source_weights),
+            destinations, checked_weights(destinations, destination_weights),
+            reorder)} {}
+
+  // Number of sources
+  [[nodiscard]]
+  auto in_degree() const -> std::size_t {
+    return degrees().first;
+  }
+
+  // Number of destinations
+  [[nodiscard]]
+  auto out_degree() const -> std::size_t {
+    return degrees().second;
+  }
+
+  [[nodiscard]]
+  auto sources() const -> std::vector<int> {
+    return neighbors().first;
+  }
+
+  [[nodiscard]]
+  auto destinations() const -> std::vector<int> {
+    return neighbors().second;
+  }
+
+ private:
+  [[nodiscard]]
+  auto degrees() const -> std::pair<std::size_t, std::size_t> {
+    int indegree = 0;
+    int outdegree = 0;
+    int weighted = 0;
+    check_mpi_result(MPI_Dist_graph_neighbors_count(this->native(), &indegree,
+                                                    &outdegree, &weighted));
+    return {static_cast<std::size_t>(indegree),
+            static_cast<std::size_t>(outdegree)};
+  }
+
+  [[nodiscard]]
+  auto neighbors() const -> std::pair<std::vector<int>, std::vector<int>> {
+    auto [indegree, outdegree] = degrees();
+    std::vector<int> srcs(indegree);
+    std::vector<int> dests(outdegree);
+    check_mpi_result(MPI_Dist_graph_neighbors(
+        this->native(), static_cast<int>(indegree), srcs.data(),
+        MPI_UNWEIGHTED, static_cast<int>(outdegree), dests.data(),
+        MPI_UNWEIGHTED));
+    return {std::move(srcs), std::move(dests)};
+  }
+
+  [[nodiscard]]
+  static auto checked_weights(std::span<const int> ranks,
+                              std::span<const int> weights) -> const int* {
+    if (ranks.size() != weights.size()) {
+      throw std::invalid_argument("weights must have one entry per neighbor");
+    }
+    return weights.empty() ? MPI_WEIGHTS_EMPTY : weights.data();
+  }
+
+  template <typename BaseHandle>
+  static auto create_dist_graph_comm(const basic_comm<BaseHandle>& base,
+                                     std::span<const int> sources,
+                                     const int* source_weights,
+                                     std::span<const int> destinations,
+                                     const int* destination_weights,
+                                     bool reorder) -> handle_type {
+    weak_comm_handle new_comm;
+    check_mpi_result(MPI_Dist_graph_create_adjacent(
+        base.native(), static_cast<int>(sources.size()), sources.data(),
+        source_weights, static_cast<int>(destinations.size()),
+        destinations.data(), destination_weights, MPI_INFO_NULL,
+        static_cast<int>(reorder), &new_comm.native()));
+    return handle_type{new_comm};
+  }
+};
+
+using dist_graph_comm = basic_dist_graph_comm<comm_handle>;
+using weak_dist_graph_comm = basic_dist_graph_comm<weak_comm_handle>;
+
+}  // namespace cxxmpi
@@ -0,0 +1,240 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <mpi.h>
+
+#include "cxxmpi/comm.hpp"
+#include "cxxmpi/dtype.hpp"
+#include "cxxmpi/window.hpp"
+
+namespace cxxmpi {
+
+// Hash map partitioned across the processes of a communicator, accessed
+// with passive-target one-sided atomics so the owner of a key takes no part
+// in its insertion or lookup. Every process holds an open-addressing table
+// of capacity slots, and a key lives in the table of process
+// hash % size, probed linearly from slot hash / size.
+//
+// Operations work on batches: each probing round issues one atomic per
+// pending key and completes them with a single flush, so a batch costs one
+// network round trip per probe step rather than per key. Keys are integers
+// because MPI_Compare_and_swap only supports those; empty_key marks a free
+// slot and cannot be inserted. There is no erase.
+//
+// Inserts and lookups may run concurrently. A lookup racing the insert of
+// the same key may not find it, or see its value before the insert stored
+// it; separate them with a synchronization such as a barrier when that
+// matters.
+template <std::integral K, typename V, typename Hash = std::hash<K>>
+  requires has_builtin_datatype<K> && has_builtin_datatype<V>
+class distributed_unordered_map {
+ public:
+  using key_type = K;
+  using mapped_type = V;
+
+  // Collective over communicator; capacity is the number of slots per
+  // process
+  template <typename Handle>
+  distributed_unordered_map(const basic_comm<Handle>& communicator,
+                            std::size_t capacity,
+                            K empty_key = std::numeric_limits<K>::max(),
+                            Hash hash = Hash{})
+      : keys_{communicator, checked_capacity(capacity)},
+        values_{communicator, capacity},
+        capacity_{capacity},
+        nprocs_{communicator.size()},
+        empty_key_{empty_key},
+        hash_{std::move(hash)} {
+    // Local stores reach the public copy of the window, which remote
+    // atomics operate on, only through MPI_Win_sync inside an epoch
+    auto epoch = keys_.lock_all();
+    std::ranges::fill(keys_.local(), empty_key_);
+    keys_.sync();
+    epoch.close();
+    // No process may probe a table before its owner cleared it
+    communicator.barrier();
+  }
+
+  // Inserts keys[i] with values[i]; the value of a present key is
+  // overwritten. Returns how many keys were not present before. Throws
+  // std::length_error if a key finds no free slot in its owner's table.
+  template <size_t KeyExtent, size_t ValueExtent>
+  auto insert(std::span<const K, KeyExtent> keys,
+              std::span<const V, ValueExtent> values) -> std::size_t {
+    assert(keys.size() == values.size());
+    auto pending = start_probes(keys);
+    std::vector<K> seen(pending.size());
+    std::size_t inserted = 0;
+
+    auto key_epoch = keys_.lock_all();
+    auto value_epoch = values_.lock_all();
+    while (!pending.empty()) {
+      for (std::size_t i = 0; i < pending.size(); ++i) {
+        auto const& p = pending[i];
+        keys_.compare_and_swap(keys[p.index], empty_key_, seen[i], p.target,
+                               p.disp());
+      }
+      key_epoch.flush_all();
+
+      std::size_t next = 0;
+      for (std::size_t i = 0; i < pending.size(); ++i) {
+        auto p = pending[i];
+        auto const key = keys[p.index];
+        if (seen[i] == empty_key_ || seen[i] == key) {
+          inserted += seen[i] == empty_key_ ? 1U : 0U;
+          values_.accumulate(values.subspan(p.index, 1), p.target, p.disp(),
+                             MPI_REPLACE);
+        } else if (advance(p)) {
+          pending[next++] = p;
+        } else {
+          throw std::length_error("distributed_unordered_map is full");
+        }
+      }
+      pending.resize(next);
+    }
+    value_epoch.close();
+    key_epoch.close();
+    return inserted;
+  }
+
+  auto insert(const K& key, const V& value) -> bool {
+    return insert(std::span{&key, 1}, std::span{&value, 1}) == 1;
+  }
+
+  // Value of every key, or nullopt for absent ones
+  template <size_t Extent>
+  [[nodiscard]]
+  auto find(std::span<const K, Extent> keys) const
+      -> std::vector<std::optional<V>> {
+    auto pending = start_probes(keys);
+    std::vector<K> seen(pending.size());
+    std::vector<V> fetched(keys.size());
+    std::vector<std::size_t> found;
+
+    auto key_epoch = keys_.lock_all();
+    auto value_epoch = values_.lock_all();
+    while (!pending.empty()) {
+      for (std::size_t i = 0; i < pending.size(); ++i) {
+        auto const& p = pending[i];
+        keys_.fetch_and_op(empty_key_, seen[i], p.target, p.disp(),
+                           MPI_NO_OP);
+      }
+      key_epoch.flush_all();
+
+      std::size_t next = 0;
+      for (std::size_t i = 0; i < pending.size(); ++i) {
+        auto p = pending[i];
+        if (seen[i] == keys[p.index]) {
+          values_.fetch_and_op(V{}, fetched[p.index], p.target, p.disp(),
+                               MPI_NO_OP);
+          found.push_back(p.index);
+        } else if (seen[i] != empty_key_ && advance(p)) {
+          pending[next++] = p;
+        }
+      }
+      pending.resize(next);
+    }
+    value_epoch.close();
+    key_epoch.close();
+
+    std::vector<std::optional<V>> result(keys.size());
+    for (auto const index : found) {
+      result[index] = fetched[index];
+    }
+    return result;
+  }
+
+  [[nodiscard]]
+  auto find(const K& key) const -> std::optional<V> {
+    return find(std::span{&key, 1}).front();
+  }
+
+  [[nodiscard]]
+  auto contains(const K& key) const -> bool {
+    return find(key).has_value();
+  }
+
+  // Keys held by this process; only meaningful while no insert is in
+  // flight, e.g. after a barrier
+  [[nodiscard]]
+  auto local_size() const -> std::size_t {
+    // Brings remote updates into the private copy before reading it
+    auto epoch = keys_.lock_all();
+    keys_.sync();
+    auto const n = std::ranges::count_if(
+        keys_.local(), [this](const K& key) { return key != empty_key_; });
+    epoch.close();
+    return static_cast<std::size_t>(n);
+  }
+
+  // Slots per process
+  [[nodiscard]]
+  auto capacity() const noexcept -> std::size_t {
+    return capacity_;
+  }
+
+ private:
+  // Checked before the windows are allocated
+  static auto checked_capacity(std::size_t capacity) -> std::size_t {
+    if (capacity == 0) {
+      throw std::invalid_argument("capacity must be positive");
+    }
+    return capacity;
+  }
+
+  // Next slot to try for keys[index]
+  struct probe {
+    std::size_t index;
+    int target;
+    std::size_t slot;
+    std::size_t step;
+
+    [[nodiscard]]
+    auto disp() const noexcept -> MPI_Aint {
+      return static_cast<MPI_Aint>(slot);
+    }
+  };
+
+  window<K> keys_;
+  window<V> values_;
+  std::size_t capacity_;
+  std::size_t nprocs_;
+  K empty_key_;
+  Hash hash_;
+
+  template <size_t Extent>
+  [[nodiscard]]
+  auto start_probes(std::span<const K, Extent> keys) const
+      -> std::vector<probe> {
+    std::vector<probe> probes;
+    probes.reserve(keys.size());
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+      if (keys[i] == empty_key_) {
+        throw std::invalid_argument("the empty key cannot be stored");
+      }
+      auto const h = static_cast<std::size_t>(hash_(keys[i]));
+      probes.push_back({i, static_cast<int>(h % nprocs_),
+                        h / nprocs_ % capacity_, 0});
+    }
+    return probes;
+  }
+
+  // Moves p to its next slot; false once the whole table was probed
+  auto advance(probe& p) const noexcept -> bool {
+    p.slot = (p.slot + 1) % capacity_;
+    return ++p.step < capacity_;
+  }
+};
+
+}  // namespace cxxmpi
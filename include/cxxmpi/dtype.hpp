@@ -36,6 +36,14 @@ template <typename T>
     return MPI_INT;
   } else if constexpr (std::is_same_v<T, unsigned int>) {
     return MPI_UNSIGNED;
+  } else if constexpr (std::is_same_v<T, signed long>) {  // NOLINT
+    return MPI_LONG;
+  } else if constexpr (std::is_same_v<T, unsigned long>) {  // NOLINT
+    return MPI_UNSIGNED_LONG;
+  } else if constexpr (std::is_same_v<T, signed long long>) {  // NOLINT
+    return MPI_LONG_LONG;
+  } else if constexpr (std::is_same_v<T, unsigned long long>) {  // NOLINT
+    return MPI_UNSIGNED_LONG_LONG;
   } else if constexpr (std::is_same_v<T, float>) {
     return MPI_FLOAT;
   } else if constexpr (std::is_same_v<T, double>) {
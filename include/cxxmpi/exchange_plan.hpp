@@ -0,0 +1,238 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <mpi.h>
+
+#include "cxxmpi/comm.hpp"
+#include "cxxmpi/dtype.hpp"
+#include "cxxmpi/error.hpp"
+#include "cxxmpi/request.hpp"
+
+namespace cxxmpi {
+
+namespace detail {
+
+// Counts, displacements and datatypes for one direction of an exchange
+class exchange_side {
+ public:
+  exchange_side() = default;
+
+  explicit exchange_side(std::size_t nprocs)
+      : counts_(nprocs),
+        displs_(nprocs),
+        types_(nprocs, MPI_DATATYPE_NULL),
+        extents_(nprocs),
+        byte_displs_(nprocs) {}
+
+  // Returns whether any count changed. Displacements are recomputed only
+  // from the first changed entry onward.
+  auto set_counts(std::span<const int> counts) -> bool {
+    if (counts.size() != counts_.size()) {
+      throw std::invalid_argument("counts must have one entry per rank");
+    }
+    auto const first = static_cast<std::size_t>(std::distance(
+        counts.begin(), std::ranges::mismatch(counts, counts_).in1));
+    if (first == counts_.size()) {
+      return false;
+    }
+    std::ranges::copy(counts.subspan(first), counts_.begin() + diff(first));
+    update_displs(first);
+    return true;
+  }
+
+  // Returns whether any datatype changed
+  auto set_types(std::span<const MPI_Datatype> types) -> bool {
+    if (types.size() != types_.size()) {
+      throw std::invalid_argument("types must have one entry per rank");
+    }
+    auto const first = static_cast<std::size_t>(std::distance(
+        types.begin(), std::ranges::mismatch(types, types_).in1));
+    if (first == types_.size()) {
+      return false;
+    }
+    for (auto i = first; i < types_.size(); ++i) {
+      if (types_[i] != types[i]) {
+        types_[i] = types[i];
+        MPI_Aint lb = 0;
+        check_mpi_result(MPI_Type_get_extent(types_[i], &lb, &extents_[i]));
+      }
+    }
+    update_byte_displs(first);
+    return true;
+  }
+
+  [[nodiscard]]
+  auto counts() const noexcept -> std::span<const int> {
+    return counts_;
+  }
+
+  [[nodiscard]]
+  auto displs() const noexcept -> std::span<const int> {
+    return displs_;
+  }
+
+  [[nodiscard]]
+  auto types() const noexcept -> std::span<const MPI_Datatype> {
+    return types_;
+  }
+
+  [[nodiscard]]
+  auto byte_displs() const noexcept -> std::span<const int> {
+    return byte_displs_;
+  }
+
+  [[nodiscard]]
+  auto total() const noexcept -> std::size_t {
+    return counts_.empty()
+             ? 0
+             : static_cast<std::size_t>(displs_.back() + counts_.back());
+  }
+
+ private:
+  static auto diff(std::size_t i) noexcept -> std::ptrdiff_t {
+    return static_cast<std::ptrdiff_t>(i);
+  }
+
+  void update_displs(std::size_t first) {
+    auto offset = first == 0 ? 0 : displs_[first - 1] + counts_[first - 1];
+    for (auto i = first; i < counts_.size(); ++i) {
+      displs_[i] = offset;
+      offset += counts_[i];
+    }
+    update_byte_displs(first);
+  }
+
+  void update_byte_displs(std::size_t first) {
+    auto offset = first == 0 ? MPI_Aint{0}
+                             : byte_displs_[first - 1]
+                                   + counts_[first - 1] * extents_[first - 1];
+    for (auto i = first; i < counts_.size(); ++i) {
+      // alltoallw takes int byte displacements
+      if (offset > std::numeric_limits<int>::max()) {
+        throw std::overflow_error(
+            "alltoallw byte displacement does not fit in an int");
+      }
+      byte_displs_[i] = static_cast<int>(offset);
+      offset += counts_[i] * extents_[i];
+    }
+  }
+
+  std::vector<int> counts_;
+  std::vector<int> displs_;
+  std::vector<MPI_Datatype> types_;
+  std::vector<MPI_Aint> extents_;
+  std::vector<int> byte_displs_;
+};
+
+}  // namespace detail
+
+// Cached counts, displacements and datatypes for repeated all-to-all
+// exchanges whose pattern changes little between iterations
+class exchange_plan {
+  detail::exchange_side send_;
+  detail::exchange_side recv_;
+  std::vector<int> counts_scratch_;
+
+ public:
+  exchange_plan() = default;
+
+  explicit exchange_plan(std::size_t nprocs)
+      : send_{nprocs}, recv_{nprocs}, counts_scratch_(nprocs) {}
+
+  template <typename Handle>
+  explicit exchange_plan(const basic_comm<Handle>& communicator)
+      : exchange_plan{communicator.size()} {}
+
+  auto set_send_counts(std::span<const int> counts) -> bool {
+    return send_.set_counts(counts);
+  }
+
+  auto set_recv_counts(std::span<const int> counts) -> bool {
+    return recv_.set_counts(counts);
+  }
+
+  // Datatypes used by alltoallw; displacements are derived from the counts
+  // and the type extents. The datatypes must outlive the plan's use.
+  auto set_send_types(std::span<const MPI_Datatype> types) -> bool {
+    return send_.set_types(types);
+  }
+
+  auto set_recv_types(std::span<const MPI_Datatype> types) -> bool {
+    return recv_.set_types(types);
+  }
+
+  // Learn the receive counts from the peers' send counts
+  template <typename Handle>
+  auto exchange_counts(const basic_comm<Handle>& communicator) -> bool {
+    communicator.alltoall(send_.counts(), std::span<int>{counts_scratch_});
+    return recv_.set_counts(counts_scratch_);
+  }
+
+  [[nodiscard]]
+  auto send_counts() const noexcept -> std::span<const int> {
+    return send_.counts();
+  }
+
+  [[nodiscard]]
+  auto send_displs() const noexcept -> std::span<const int> {
+    return send_.displs();
+  }
+
+  [[nodiscard]]
+  auto recv_counts() const noexcept -> std::span<const int> {
+    return recv_.counts();
+  }
+
+  [[nodiscard]]
+  auto recv_displs() const noexcept -> std::span<const int> {
+    return recv_.displs();
+  }
+
+  // Number of elements sent / received in total
+  [[nodiscard]]
+  auto send_size() const noexcept -> std::size_t {
+    return send_.total();
+  }
+
+  [[nodiscard]]
+  auto recv_size() const noexcept -> std::size_t {
+    return recv_.total();
+  }
+
+  template <typename Handle, typename T, size_t SendExtent, size_t RecvExtent>
+  void alltoallv(const basic_comm<Handle>& communicator,
+                 std::span<const T, SendExtent> send_data,
+                 std::span<T, RecvExtent> recv_data) const {
+    communicator.alltoallv(send_data, send_.counts(), send_.displs(),
+                           recv_data, recv_.counts(), recv_.displs());
+  }
+
+  // The request owns a copy of the counts and displacements, so the plan
+  // may change while it is in flight
+  template <typename Handle, typename T, size_t SendExtent, size_t RecvExtent>
+  [[nodiscard]]
+  auto ialltoallv(const basic_comm<Handle>& communicator,
+                  std::span<const T, SendExtent> send_data,
+                  std::span<T, RecvExtent> recv_data) const -> request {
+    return communicator.ialltoallv(send_data, send_.counts(), send_.displs(),
+                                   recv_data, recv_.counts(), recv_.displs());
+  }
+
+  template <typename Handle>
+  void alltoallw(const basic_comm<Handle>& communicator,
+                 const void* send_data,
+                 void* recv_data) const {
+    communicator.alltoallw(send_data, send_.counts(), send_.byte_displs(),
+                           send_.types(), recv_data, recv_.counts(),
+                           recv_.byte_displs(), recv_.types());
+  }
+};
+
+}  // namespace cxxmpi
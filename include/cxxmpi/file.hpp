@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstddef>
+#include <functional>
 #include <memory>
 #include <span>
 #include <string>
@@ -12,6 +13,7 @@
 #include "cxxmpi/comm.hpp"
 #include "cxxmpi/dtype.hpp"
 #include "cxxmpi/error.hpp"
+#include "cxxmpi/request.hpp"
 
 namespace cxxmpi {
 
@@ -146,10 +148,10 @@ class basic_file {
   void write_at(MPI_Offset offset,
                 const void* data,
                 int count,
-                const weak_dtype& dtype,
+                const weak_dtype& data_type,
                 MPI_Status* status = MPI_STATUS_IGNORE) {
     check_mpi_result(MPI_File_write_at(native(), offset, data, count,
-                                       dtype.native(), status));
+                                       data_type.native(), status));
   }
 
   template <typename T, std::size_t Extent>
@@ -164,10 +166,10 @@ class basic_file {
   void read_at(MPI_Offset offset,
                const void* data,
                int count,
-               const weak_dtype& dtype,
+               const weak_dtype& data_type,
                MPI_Status* status = MPI_STATUS_IGNORE) {
     check_mpi_result(MPI_File_read_at(native(), offset, data, count,
-                                      dtype.native(), status));
+                                      data_type.native(), status));
   }
 
   template <typename T, std::size_t Extent>
@@ -182,10 +184,10 @@ class basic_file {
   void write_at_all(MPI_Offset offset,
                     const void* data,
                     int count,
-                    const weak_dtype& dtype,
+                    const weak_dtype& data_type,
                     MPI_Status* status = MPI_STATUS_IGNORE) {
     check_mpi_result(MPI_File_write_at_all(native(), offset, data, count,
-                                           dtype.native(), status));
+                                           data_type.native(), status));
   }
 
   template <typename T, std::size_t Extent>
@@ -200,10 +202,32 @@ class basic_file {
   void read_at_all(MPI_Offset offset,
                    const void* data,
                    int count,
-                   const weak_dtype& dtype,
+                   const weak_dtype& data_type,
                    MPI_Status* status = MPI_STATUS_IGNORE) {
     check_mpi_result(MPI_File_read_at_all(native(), offset, data, count,
-                                          dtype.native(), status));
+                                          data_type.native(), status));
+  }
+
+  // Non-blocking write; data must stay valid until the request completes
+  template <typename T, std::size_t Extent>
+  [[nodiscard]]
+  auto iwrite_at(MPI_Offset offset, std::span<const T, Extent> data)
+      -> request {
+    MPI_Request req = MPI_REQUEST_NULL;
+    check_mpi_result(MPI_File_iwrite_at(native(), offset, data.data(),
+                                        static_cast<int>(data.size()),
+                                        as_builtin_datatype<T>(), &req));
+    return request{req};
+  }
+
+  template <typename T, std::size_t Extent>
+  [[nodiscard]]
+  auto iread_at(MPI_Offset offset, std::span<T, Extent> data) -> request {
+    MPI_Request req = MPI_REQUEST_NULL;
+    check_mpi_result(MPI_File_iread_at(native(), offset, data.data(),
+                                       static_cast<int>(data.size()),
+                                       as_builtin_datatype<T>(), &req));
+    return request{req};
   }
 
  private:
@@ -213,14 +237,23 @@ class basic_file {
 using file = basic_file<file_handle>;
 using weak_file = basic_file<weak_file_handle>;
 
+// Starting offset of this rank when every rank writes local_size bytes
+// back to back in rank order, e.g. for write_at_all
+template <typename Handle>
+[[nodiscard]]
+auto exscan_offset(const basic_comm<Handle>& communicator,
+                   MPI_Offset local_size) -> MPI_Offset {
+  return communicator.exscan(local_size, std::plus<>{});
+}
+
 [[nodiscard]]
 inline auto open(const std::string& filename,
-                 const weak_comm& comm,
+                 const weak_comm& communicator,
                  int mode,
                  MPI_Info info = MPI_INFO_NULL) -> file {
   weak_file_handle fh;
-  check_mpi_result(
-      MPI_File_open(comm.native(), filename.c_str(), mode, info, &fh.native()));
+  check_mpi_result(MPI_File_open(communicator.native(), filename.c_str(), mode,
+                                 info, &fh.native()));
   return file{file_handle{fh}};
 }
 
@@ -0,0 +1,224 @@
+#pragma once
+
+#include <cstddef>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <mpi.h>
+
+#include "cxxmpi/cart_comm.hpp"
+#include "cxxmpi/dtype.hpp"
+#include "cxxmpi/persistent_channel.hpp"
+
+namespace cxxmpi {
+
+// Ghost-layer exchange for a row-major (MPI_ORDER_C) block distributed
+// over a cartesian communicator. Each local dimension holds extents[d]
+// interior cells padded by ghost_width cells on both sides. The face, edge
+// and corner regions of all 3^N - 1 neighbors are described once by cached
+// subarray datatypes and bound to persistent requests, so an iteration
+// costs one MPI_Startall and one MPI_Waitall. Neighbors beyond a
+// non-periodic boundary are skipped.
+//
+// The exchanger keeps references to the buffer and to the communicator;
+// both must outlive it.
+template <typename T>
+class halo_exchanger {
+ public:
+  template <typename Handle>
+  halo_exchanger(const basic_cart_comm<Handle>& cart,
+                 std::span<T> data,
+                 std::span<const int> extents,
+                 int ghost_width,
+                 const weak_dtype& element_type,
+                 int tag = 0)
+      : extents_(extents.begin(), extents.end()), ghost_width_{ghost_width} {
+    validate(cart, data);
+    build(cart, data, element_type, tag);
+  }
+
+  template <typename Handle>
+  halo_exchanger(const basic_cart_comm<Handle>& cart,
+                 std::span<T> data,
+                 std::span<const int> extents,
+                 int ghost_width,
+                 int tag = 0)
+    requires has_builtin_datatype<T>
+      : halo_exchanger{cart, data, extents, ghost_width, as_weak_dtype<T>(),
+                       tag} {}
+
+  halo_exchanger(const halo_exchanger&) = delete;
+  auto operator=(const halo_exchanger&) -> halo_exchanger& = delete;
+  halo_exchanger(halo_exchanger&&) noexcept = default;
+  auto operator=(halo_exchanger&&) noexcept -> halo_exchanger& = default;
+  ~halo_exchanger() = default;
+
+  // Starts all ghost-layer transfers. The interior cells may be updated
+  // until end(); the boundary cells being sent and the ghost cells must
+  // not be touched.
+  void begin() {
+    if (channels_.active()) {
+      throw std::logic_error("halo exchange is already in progress");
+    }
+    channels_.start_all();
+  }
+
+  // Completes the transfers started by begin(); the ghost cells are valid
+  // afterwards
+  void end() {
+    if (!channels_.active()) {
+      throw std::logic_error("halo exchange has not been started");
+    }
+    channels_.wait_all();
+  }
+
+  void exchange() {
+    begin();
+    end();
+  }
+
+  [[nodiscard]]
+  auto active() const noexcept -> bool {
+    return channels_.active();
+  }
+
+  // Number of neighbors that exchange data with this process, counting a
+  // rank once per direction it is reached in
+  [[nodiscard]]
+  auto neighbor_count() const noexcept -> std::size_t {
+    return channels_.size() / 2;
+  }
+
+  [[nodiscard]]
+  auto extents() const noexcept -> std::span<const int> {
+    return extents_;
+  }
+
+  [[nodiscard]]
+  auto ghost_width() const noexcept -> int {
+    return ghost_width_;
+  }
+
+ private:
+  std::vector<int> extents_;
+  int ghost_width_;
+  std::vector<dtype> types_;
+  channel_group channels_;
+
+  template <typename Handle>
+  void validate(const basic_cart_comm<Handle>& cart,
+                std::span<const T> data) const {
+    if (extents_.size() != cart.ndims()) {
+      throw std::invalid_argument(
+          "extents must have one entry per cartesian dimension");
+    }
+    if (ghost_width_ <= 0) {
+      throw std::invalid_argument("ghost width must be positive");
+    }
+    for (auto extent : extents_) {
+      if (extent < ghost_width_) {
+        throw std::invalid_argument("extents must not be below ghost width");
+      }
+    }
+    auto const padded = std::accumulate(
+        extents_.begin(), extents_.end(), std::size_t{1},
+        [this](std::size_t n, int extent) {
+          return n * static_cast<std::size_t>(extent + 2 * ghost_width_);
+        });
+    if (data.size() != padded) {
+      throw std::invalid_argument(
+          "data must hold the interior and ghost cells of every dimension");
+    }
+  }
+
+  template <typename Handle>
+  void build(const basic_cart_comm<Handle>& cart,
+             std::span<T> data,
+             const weak_dtype& element_type,
+             int tag) {
+    auto const num_dims = extents_.size();
+    std::vector<int> sizes(num_dims);
+    for (std::size_t d = 0; d < num_dims; ++d) {
+      sizes[d] = extents_[d] + 2 * ghost_width_;
+    }
+
+    // Offset k encodes one step in {-1, 0, 1} per dimension, most
+    // significant dimension first; 3^N - 1 - k is the opposite direction
+    std::size_t num_offsets = 1;
+    for (std::size_t d = 0; d < num_dims; ++d) {
+      num_offsets *= 3;
+    }
+    auto const center = num_offsets / 2;
+
+    std::vector<int> step(num_dims);
+    std::vector<int> subsizes(num_dims);
+    std::vector<int> send_starts(num_dims);
+    std::vector<int> recv_starts(num_dims);
+    std::vector<persistent_channel> sends;
+    for (std::size_t k = 0; k < num_offsets; ++k) {
+      if (k == center) {
+        continue;
+      }
+      decode(k, step);
+      auto const peer = cart.neighbor(step);
+      if (peer == MPI_PROC_NULL) {
+        continue;
+      }
+      for (std::size_t d = 0; d < num_dims; ++d) {
+        region(d, step[d], subsizes[d], send_starts[d], recv_starts[d]);
+      }
+
+      types_.emplace_back(element_type, sizes, subsizes, send_starts)
+          .commit();
+      auto const send_type = weak_dtype{types_.back()};
+      types_.emplace_back(element_type, sizes, subsizes, recv_starts)
+          .commit();
+      auto const recv_type = weak_dtype{types_.back()};
+
+      // The peer sends its data for us along the opposite offset
+      auto const send_tag = tag + static_cast<int>(k);
+      auto const recv_tag = tag + static_cast<int>(num_offsets - 1 - k);
+      channels_.add(cart.recv_init(data, recv_type, 1, peer, recv_tag));
+      sends.push_back(cart.send_init(std::span<const T>{data}, send_type, 1,
+                                     peer, send_tag));
+    }
+    // Receives are posted ahead of the sends by every MPI_Startall
+    for (auto& send : sends) {
+      channels_.add(std::move(send));
+    }
+  }
+
+  static void decode(std::size_t k, std::span<int> step) noexcept {
+    for (auto d = step.size(); d-- > 0;) {
+      step[d] = static_cast<int>(k % 3) - 1;
+      k /= 3;
+    }
+  }
+
+  // Region of one dimension sent to and received from a step of -1, 0 or 1
+  void region(std::size_t d,
+              int direction,
+              int& subsize,
+              int& send_start,
+              int& recv_start) const noexcept {
+    auto const g = ghost_width_;
+    auto const n = extents_[d];
+    if (direction == 0) {
+      subsize = n;
+      send_start = g;
+      recv_start = g;
+    } else if (direction < 0) {
+      subsize = g;
+      send_start = g;
+      recv_start = 0;
+    } else {
+      subsize = g;
+      send_start = n;
+      recv_start = n + g;
+    }
+  }
+};
+
+}  // namespace cxxmpi
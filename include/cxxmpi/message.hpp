@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cassert>
+#include <span>
+#include <utility>
+
+#include <mpi.h>
+
+#include "cxxmpi/dtype.hpp"
+#include "cxxmpi/error.hpp"
+#include "cxxmpi/request.hpp"
+#include "cxxmpi/status.hpp"
+
+namespace cxxmpi {
+
+// Message matched by basic_comm::mprobe/improbe. It is removed from the
+// matching queue, so no other receive can take it before recv() does; this
+// makes probe-then-receive race-free under MPI_THREAD_MULTIPLE. A matched
+// message must be received exactly once.
+class message {
+  MPI_Message message_{MPI_MESSAGE_NULL};
+
+ public:
+  message() = default;
+
+  explicit message(MPI_Message msg) noexcept : message_{msg} {}
+
+  message(const message&) = delete;
+  auto operator=(const message&) -> message& = delete;
+
+  message(message&& other) noexcept
+      : message_{std::exchange(other.message_, MPI_MESSAGE_NULL)} {}
+
+  // The target must not hold a matched message that was not received yet;
+  // it could never be received afterwards
+  auto operator=(message&& other) noexcept -> message& {
+    if (this != &other) {
+      assert(message_ == MPI_MESSAGE_NULL ||
+             message_ == MPI_MESSAGE_NO_PROC);
+      message_ = std::exchange(other.message_, MPI_MESSAGE_NULL);
+    }
+    return *this;
+  }
+
+  ~message() = default;
+
+  [[nodiscard]]
+  explicit operator bool() const noexcept {
+    return message_ != MPI_MESSAGE_NULL;
+  }
+
+  [[nodiscard]]
+  auto native() const noexcept -> MPI_Message {
+    return message_;
+  }
+
+  // Receive - custom datatype with count
+  template <typename T, size_t Extent>
+  auto recv(std::span<T, Extent> data, const weak_dtype& data_type, int count)
+      -> status {
+    status st;
+    check_mpi_result(MPI_Mrecv(data.data(), count, data_type.native(),
+                               &message_, &st.native()));
+    return st;
+  }
+
+  // Receive - builtin datatype with count
+  template <typename T, size_t Extent>
+  auto recv(std::span<T, Extent> data) -> status {
+    return recv(data, as_weak_dtype<T>(), static_cast<int>(data.size()));
+  }
+
+  // Nonblocking receive - custom datatype with count
+  template <typename T, size_t Extent>
+  [[nodiscard]]
+  auto irecv(std::span<T, Extent> data, const weak_dtype& data_type, int count)
+      -> request {
+    MPI_Request req = MPI_REQUEST_NULL;
+    check_mpi_result(
+        MPI_Imrecv(data.data(), count, data_type.native(), &message_, &req));
+    return request{req};
+  }
+
+  // Nonblocking receive - builtin datatype with count
+  template <typename T, size_t Extent>
+  [[nodiscard]]
+  auto irecv(std::span<T, Extent> data) -> request {
+    return irecv(data, as_weak_dtype<T>(), static_cast<int>(data.size()));
+  }
+};
+
+}  // namespace cxxmpi
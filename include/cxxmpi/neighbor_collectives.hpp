@@ -0,0 +1,225 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <mpi.h>
+
+#include "cxxmpi/dtype.hpp"
+#include "cxxmpi/error.hpp"
+#include "cxxmpi/persistent_collective.hpp"
+#include "cxxmpi/request.hpp"
+
+namespace cxxmpi {
+
+// Neighborhood collectives for communicators with a process topology. A
+// sparse exchange with all neighbors is a single collective, which lets the
+// MPI implementation schedule it as a whole.
+//
+// Derived provides native(), in_degree() and out_degree(). Buffers are laid
+// out in the topology's neighbor order: for a cartesian communicator the
+// negative then the positive neighbor of each dimension, for a distributed
+// graph the order of its sources and destinations.
+template <typename Derived>
+class neighbor_collectives {
+ public:
+  // Neighbor allgather - every neighbor receives the same send_data
+  template <typename T, size_t SendExtent, size_t RecvExtent>
+  void neighbor_allgather(std::span<const T, SendExtent> send_data,
+                          std::span<T, RecvExtent> recv_data) const {
+    auto const count = static_cast<int>(send_data.size());
+    assert(recv_data.size() == send_data.size() * derived().in_degree());
+    check_mpi_result(MPI_Neighbor_allgather(
+        send_data.data(), count, as_builtin_datatype<T>(), recv_data.data(),
+        count, as_builtin_datatype<T>(), derived().native()));
+  }
+
+  // Neighbor alltoall - send_data split evenly across the destinations
+  template <typename T, size_t SendExtent, size_t RecvExtent>
+  void neighbor_alltoall(std::span<const T, SendExtent> send_data,
+                         std::span<T, RecvExtent> recv_data) const {
+    auto const count = block_count(send_data.size(), recv_data.size());
+    check_mpi_result(MPI_Neighbor_alltoall(
+        send_data.data(), count, as_builtin_datatype<T>(), recv_data.data(),
+        count, as_builtin_datatype<T>(), derived().native()));
+  }
+
+  // Neighbor alltoallv - counts and displacements per destination/source
+  template <typename T, size_t SendExtent, size_t RecvExtent>
+  void neighbor_alltoallv(std::span<const T, SendExtent> send_data,
+                          std::span<const int> send_counts,
+                          std::span<const int> send_displs,
+                          std::span<T, RecvExtent> recv_data,
+                          std::span<const int> recv_counts,
+                          std::span<const int> recv_displs) const {
+    check_degrees(send_counts, send_displs, recv_counts, recv_displs);
+    check_mpi_result(MPI_Neighbor_alltoallv(
+        send_data.data(), send_counts.data(), send_displs.data(),
+        as_builtin_datatype<T>(), recv_data.data(), recv_counts.data(),
+        recv_displs.data(), as_builtin_datatype<T>(), derived().native()));
+  }
+
+  template <typename T, size_t SendExtent, size_t RecvExtent>
+  [[nodiscard]]
+  auto ineighbor_allgather(std::span<const T, SendExtent> send_data,
+                           std::span<T, RecvExtent> recv_data) const
+      -> request {
+    auto const count = static_cast<int>(send_data.size());
+    assert(recv_data.size() == send_data.size() * derived().in_degree());
+    MPI_Request req = MPI_REQUEST_NULL;
+    check_mpi_result(MPI_Ineighbor_allgather(
+        send_data.data(), count, as_builtin_datatype<T>(), recv_data.data(),
+        count, as_builtin_datatype<T>(), derived().native(), &req));
+    return request{req};
+  }
+
+  template <typename T, size_t SendExtent, size_t RecvExtent>
+  [[nodiscard]]
+  auto ineighbor_alltoall(std::span<const T, SendExtent> send_data,
+                          std::span<T, RecvExtent> recv_data) const
+      -> request {
+    auto const count = block_count(send_data.size(), recv_data.size());
+    MPI_Request req = MPI_REQUEST_NULL;
+    check_mpi_result(MPI_Ineighbor_alltoall(
+        send_data.data(), count, as_builtin_datatype<T>(), recv_data.data(),
+        count, as_builtin_datatype<T>(), derived().native(), &req));
+    return request{req};
+  }
+
+  template <typename T, size_t SendExtent, size_t RecvExtent>
+  [[nodiscard]]
+  auto ineighbor_alltoallv(std::span<const T, SendExtent> send_data,
+                           std::span<const int> send_counts,
+                           std::span<const int> send_displs,
+                           std::span<T, RecvExtent> recv_data,
+                           std::span<const int> recv_counts,
+                           std::span<const int> recv_displs) const
+      -> request {
+    check_degrees(send_counts, send_displs, recv_counts, recv_displs);
+    auto args = pack_args(send_counts, send_displs, recv_counts, recv_displs);
+    auto const* a = args.data();
+    auto const outs = send_counts.size();
+    MPI_Request req = MPI_REQUEST_NULL;
+    check_mpi_result(MPI_Ineighbor_alltoallv(
+        send_data.data(), a, a + outs, as_builtin_datatype<T>(),
+        recv_data.data(), a + (2 * outs), a + (2 * outs) + recv_counts.size(),
+        as_builtin_datatype<T>(), derived().native(), &req));
+    return request{req, std::move(args)};
+  }
+
+  // Persistent neighbor collectives; see persistent_collective for the
+  // pre-MPI-4 fallback
+  template <typename T, size_t SendExtent, size_t RecvExtent>
+  [[nodiscard]]
+  auto neighbor_allgather_init(std::span<const T, SendExtent> send_data,
+                               std::span<T, RecvExtent> recv_data) const
+      -> persistent_collective {
+    auto const count = static_cast<int>(send_data.size());
+    assert(recv_data.size() == send_data.size() * derived().in_degree());
+#if defined(CXXMPI_HAS_PERSISTENT_COLLECTIVES)
+    MPI_Request req = MPI_REQUEST_NULL;
+    check_mpi_result(MPI_Neighbor_allgather_init(
+        send_data.data(), count, as_builtin_datatype<T>(), recv_data.data(),
+        count, as_builtin_datatype<T>(), derived().native(), MPI_INFO_NULL,
+        &req));
+    return persistent_collective{req, {}};
+#else
+    return persistent_collective{
+        [sbuf = send_data.data(), rbuf = recv_data.data(), count,
+         mpi_comm = derived().native()](MPI_Request* req) {
+          return MPI_Ineighbor_allgather(sbuf, count, as_builtin_datatype<T>(),
+                                         rbuf, count, as_builtin_datatype<T>(),
+                                         mpi_comm, req);
+        },
+        {}};
+#endif
+  }
+
+  template <typename T, size_t SendExtent, size_t RecvExtent>
+  [[nodiscard]]
+  auto neighbor_alltoallv_init(std::span<const T, SendExtent> send_data,
+                               std::span<const int> send_counts,
+                               std::span<const int> send_displs,
+                               std::span<T, RecvExtent> recv_data,
+                               std::span<const int> recv_counts,
+                               std::span<const int> recv_displs) const
+      -> persistent_collective {
+    check_degrees(send_counts, send_displs, recv_counts, recv_displs);
+    auto args = pack_args(send_counts, send_displs, recv_counts, recv_displs);
+    auto const* a = args.data();
+    auto const outs = send_counts.size();
+    auto const ins = recv_counts.size();
+#if defined(CXXMPI_HAS_PERSISTENT_COLLECTIVES)
+    MPI_Request req = MPI_REQUEST_NULL;
+    check_mpi_result(MPI_Neighbor_alltoallv_init(
+        send_data.data(), a, a + outs, as_builtin_datatype<T>(),
+        recv_data.data(), a + (2 * outs), a + (2 * outs) + ins,
+        as_builtin_datatype<T>(), derived().native(), MPI_INFO_NULL, &req));
+    return persistent_collective{req, std::move(args)};
+#else
+    return persistent_collective{
+        [sbuf = send_data.data(), rbuf = recv_data.data(), a, outs, ins,
+         mpi_comm = derived().native()](MPI_Request* req) {
+          return MPI_Ineighbor_alltoallv(
+              sbuf, a, a + outs, as_builtin_datatype<T>(), rbuf,
+              a + (2 * outs), a + (2 * outs) + ins, as_builtin_datatype<T>(),
+              mpi_comm, req);
+        },
+        std::move(args)};
+#endif
+  }
+
+ protected:
+  neighbor_collectives() = default;
+
+ private:
+  [[nodiscard]]
+  auto derived() const noexcept -> const Derived& {
+    return static_cast<const Derived&>(*this);
+  }
+
+  // Elements exchanged with each neighbor by neighbor_alltoall
+  [[nodiscard]]
+  auto block_count(size_t send_size,
+                   [[maybe_unused]] size_t recv_size) const -> int {
+    auto const outs = derived().out_degree();
+    if (outs == 0) {
+      return 0;
+    }
+    assert(send_size % outs == 0);
+    assert(recv_size == send_size / outs * derived().in_degree());
+    return static_cast<int>(send_size / outs);
+  }
+
+  void check_degrees(
+      [[maybe_unused]] std::span<const int> send_counts,
+      [[maybe_unused]] std::span<const int> send_displs,
+      [[maybe_unused]] std::span<const int> recv_counts,
+      [[maybe_unused]] std::span<const int> recv_displs) const {
+    assert(send_counts.size() == derived().out_degree());
+    assert(send_displs.size() == send_counts.size());
+    assert(recv_counts.size() == derived().in_degree());
+    assert(recv_displs.size() == recv_counts.size());
+  }
+
+  // Send counts and displacements followed by the receive ones, owned by
+  // the request
+  [[nodiscard]]
+  static auto pack_args(std::span<const int> send_counts,
+                        std::span<const int> send_displs,
+                        std::span<const int> recv_counts,
+                        std::span<const int> recv_displs) -> std::vector<int> {
+    auto args = std::vector<int>{};
+    args.reserve(2 * (send_counts.size() + recv_counts.size()));
+    for (auto const part :
+         {send_counts, send_displs, recv_counts, recv_displs}) {
+      args.insert(args.end(), part.begin(), part.end());
+    }
+    return args;
+  }
+};
+
+}  // namespace cxxmpi
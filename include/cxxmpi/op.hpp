@@ -0,0 +1,260 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <mpi.h>
+
+#include "cxxmpi/error.hpp"
+
+namespace cxxmpi {
+
+namespace detail {
+
+template <typename Op, template <typename> class Fn>
+constexpr bool is_functor_of_v = false;
+
+template <typename T, template <typename> class Fn>
+constexpr bool is_functor_of_v<Fn<T>, Fn> = true;
+
+template <typename Op>
+constexpr bool is_builtin_op_v =
+    is_functor_of_v<Op, std::plus> || is_functor_of_v<Op, std::multiplies>
+    || is_functor_of_v<Op, std::logical_and>
+    || is_functor_of_v<Op, std::logical_or>
+    || is_functor_of_v<Op, std::bit_and> || is_functor_of_v<Op, std::bit_or>
+    || is_functor_of_v<Op, std::bit_xor>
+    || std::same_as<Op, std::remove_cvref_t<decltype(std::ranges::max)>>
+    || std::same_as<Op, std::remove_cvref_t<decltype(std::ranges::min)>>;
+
+}  // namespace detail
+
+// Function objects that map onto a predefined MPI_Op at compile time
+template <typename Op>
+concept builtin_op = detail::is_builtin_op_v<std::remove_cvref_t<Op>>;
+
+template <builtin_op Op>
+[[nodiscard]] constexpr auto as_builtin_op() noexcept -> MPI_Op {
+  using op_type = std::remove_cvref_t<Op>;
+  if constexpr (detail::is_functor_of_v<op_type, std::plus>) {
+    return MPI_SUM;
+  } else if constexpr (detail::is_functor_of_v<op_type, std::multiplies>) {
+    return MPI_PROD;
+  } else if constexpr (detail::is_functor_of_v<op_type, std::logical_and>) {
+    return MPI_LAND;
+  } else if constexpr (detail::is_functor_of_v<op_type, std::logical_or>) {
+    return MPI_LOR;
+  } else if constexpr (detail::is_functor_of_v<op_type, std::bit_and>) {
+    return MPI_BAND;
+  } else if constexpr (detail::is_functor_of_v<op_type, std::bit_or>) {
+    return MPI_BOR;
+  } else if constexpr (detail::is_functor_of_v<op_type, std::bit_xor>) {
+    return MPI_BXOR;
+  } else if constexpr (std::same_as<
+                           op_type,
+                           std::remove_cvref_t<decltype(std::ranges::max)>>) {
+    return MPI_MAX;
+  } else {
+    return MPI_MIN;
+  }
+}
+
+class weak_op_handle {
+  MPI_Op op_{MPI_OP_NULL};
+
+ public:
+  constexpr weak_op_handle() noexcept = default;
+  // NOLINTNEXTLINE
+  weak_op_handle(std::nullptr_t) noexcept {}
+  // NOLINTNEXTLINE
+  constexpr weak_op_handle(MPI_Op op) noexcept : op_{op} {}
+
+  [[nodiscard]]
+  explicit operator bool() const noexcept {
+    return op_ != MPI_OP_NULL;
+  }
+
+  // Smart reference pattern
+  [[nodiscard]]
+  constexpr auto operator->() noexcept -> weak_op_handle* {
+    return this;
+  }
+  [[nodiscard]]
+  constexpr auto operator->() const noexcept -> const weak_op_handle* {
+    return this;
+  }
+
+  [[nodiscard]]
+  constexpr auto native() const noexcept -> MPI_Op {
+    return op_;
+  }
+
+  [[nodiscard]]
+  constexpr auto get() const noexcept -> weak_op_handle {
+    return *this;
+  }
+
+  [[nodiscard]]
+  auto release() noexcept -> MPI_Op {
+    return std::exchange(op_, MPI_OP_NULL);
+  }
+
+  constexpr friend auto operator==(const weak_op_handle& l,
+                                   const weak_op_handle& r) noexcept -> bool {
+    return l.op_ == r.op_;
+  }
+
+  constexpr friend auto operator!=(const weak_op_handle& l,
+                                   const weak_op_handle& r) noexcept -> bool {
+    return !(l == r);
+  }
+};
+
+namespace detail {
+struct op_deleter {
+  using pointer = weak_op_handle;
+
+  void operator()(weak_op_handle handle) const noexcept {
+    if (handle) {
+      MPI_Op op = handle.release();
+      MPI_Op_free(&op);
+    }
+  }
+};
+
+template <typename Fn>
+struct op_signature : op_signature<decltype(&Fn::operator())> {};
+
+template <typename C, typename R, typename A, typename B>
+struct op_signature<R (C::*)(A, B) const> {
+  using element_type = std::remove_cvref_t<A>;
+};
+
+template <typename C, typename R, typename A, typename B>
+struct op_signature<R (C::*)(A, B) const noexcept> {
+  using element_type = std::remove_cvref_t<A>;
+};
+
+// Calls Fn element-wise over the contiguous arrays handed in by MPI.
+// Fn is stateless and known at compile time, so the loop body is inlined
+// and left to the compiler to vectorize.
+template <typename T, typename Fn>
+void user_function(void* invec,
+                   void* inoutvec,
+                   int* len,
+                   MPI_Datatype* /*datatype*/) {
+  const auto* in = static_cast<const T*>(invec);
+  auto* inout = static_cast<T*>(inoutvec);
+  const auto n = static_cast<std::size_t>(*len);
+  for (std::size_t i = 0; i < n; ++i) {
+    inout[i] = Fn{}(in[i], inout[i]);  // NOLINT
+  }
+}
+}  // namespace detail
+
+using op_handle = std::unique_ptr<weak_op_handle, detail::op_deleter>;
+
+template <typename Handle>
+class basic_op {
+ public:
+  using handle_type = Handle;
+
+  constexpr basic_op() noexcept = default;
+  constexpr basic_op(const basic_op& other) = delete;
+  constexpr basic_op(basic_op&& other) noexcept = default;
+  constexpr auto operator=(const basic_op& other) -> basic_op& = delete;
+  constexpr auto operator=(basic_op&& other) noexcept -> basic_op& = default;
+  constexpr ~basic_op() = default;
+
+  constexpr basic_op(const basic_op& other)
+    requires std::copy_constructible<handle_type>
+      : handle_{other.handle_} {}
+  constexpr auto operator=(const basic_op& other) -> basic_op&
+    requires std::is_copy_assignable_v<handle_type>
+  {
+    if (this != &other) {
+      handle_ = other.handle_;
+    }
+    return *this;
+  }
+
+  explicit basic_op(handle_type handle) : handle_{std::move(handle)} {}
+
+  // op to weak_op
+  constexpr explicit basic_op(const basic_op<op_handle>& other)
+    requires std::same_as<handle_type, weak_op_handle>
+      : handle_{weak_op_handle{other.native()}} {}
+
+  // user-defined operator constructor
+  // fn must be a stateless callable computing `in op inout` for two
+  // elements, e.g. [](const T& in, const T& inout) -> T { ... }
+  template <typename Fn>
+  explicit basic_op(Fn /*fn*/, bool commute = true)
+    requires std::same_as<handle_type, op_handle> && std::is_empty_v<Fn>
+                 && std::default_initializable<Fn>
+      : handle_{create_user_op<
+            typename detail::op_signature<Fn>::element_type, Fn>(commute)} {}
+
+  [[nodiscard]]
+  constexpr auto native() const noexcept -> MPI_Op {
+    return handle_->native();
+  }
+
+  [[nodiscard]]
+  auto commutative() const -> bool {
+    int commute = 0;
+    check_mpi_result(MPI_Op_commutative(native(), &commute));
+    return commute != 0;
+  }
+
+ private:
+  handle_type handle_;
+
+  template <typename T, typename Fn>
+  [[nodiscard]]
+  static auto create_user_op(bool commute) -> op_handle {
+    MPI_Op op = MPI_OP_NULL;
+    check_mpi_result(MPI_Op_create(&detail::user_function<T, Fn>,
+                                   commute ? 1 : 0, &op));
+    return op_handle{op};
+  }
+};
+
+using op = basic_op<op_handle>;
+using weak_op = basic_op<weak_op_handle>;
+
+template <builtin_op Op>
+[[nodiscard]]
+constexpr auto as_weak_op() noexcept -> weak_op {
+  return weak_op{weak_op_handle{as_builtin_op<Op>()}};
+}
+
+// Anything a reduction collective accepts as its operator
+template <typename Op>
+concept reduction_op =
+    builtin_op<Op> || std::same_as<std::remove_cvref_t<Op>, MPI_Op>
+    || std::same_as<std::remove_cvref_t<Op>, op>
+    || std::same_as<std::remove_cvref_t<Op>, weak_op>;
+
+namespace detail {
+
+template <reduction_op Op>
+[[nodiscard]] constexpr auto native_op(
+    [[maybe_unused]] const Op& operation) noexcept -> MPI_Op {
+  if constexpr (builtin_op<Op>) {
+    return as_builtin_op<Op>();
+  } else if constexpr (std::same_as<std::remove_cvref_t<Op>, MPI_Op>) {
+    return operation;
+  } else {
+    return operation.native();
+  }
+}
+
+}  // namespace detail
+
+}  // namespace cxxmpi
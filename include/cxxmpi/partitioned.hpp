@@ -0,0 +1,241 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <mpi.h>
+
+#include "cxxmpi/comm.hpp"
+#include "cxxmpi/dtype.hpp"
+#include "cxxmpi/error.hpp"
+
+namespace cxxmpi {
+
+namespace detail {
+
+// State shared by both sides of a partitioned transfer. With MPI-4
+// (CXXMPI_HAS_PARTITIONED_COMMUNICATION) this is a single partitioned
+// request. Otherwise every partition travels as its own message with tag
+// `tag + partition`, so that tag range is reserved for the transfer and both
+// sides must use the same number of partitions.
+template <typename T>
+class partitioned_channel {
+ public:
+  partitioned_channel() = default;
+
+  partitioned_channel(const partitioned_channel&) = delete;
+  auto operator=(const partitioned_channel&) -> partitioned_channel& = delete;
+
+  partitioned_channel(partitioned_channel&& other) noexcept
+      : data_{std::exchange(other.data_, {})},
+        partitions_{std::exchange(other.partitions_, 0)},
+        peer_{other.peer_},
+        tag_{other.tag_},
+        comm_{other.comm_},
+        requests_{std::move(other.requests_)},
+        in_flight_{std::exchange(other.in_flight_, false)} {}
+
+  auto operator=(partitioned_channel&& other) noexcept
+      -> partitioned_channel& {
+    if (this != &other) {
+      release();
+      data_ = std::exchange(other.data_, {});
+      partitions_ = std::exchange(other.partitions_, 0);
+      peer_ = other.peer_;
+      tag_ = other.tag_;
+      comm_ = other.comm_;
+      requests_ = std::move(other.requests_);
+      in_flight_ = std::exchange(other.in_flight_, false);
+    }
+    return *this;
+  }
+
+  ~partitioned_channel() { release(); }
+
+  [[nodiscard]]
+  auto partitions() const noexcept -> std::size_t {
+    return partitions_;
+  }
+
+  // Elements of the buffer belonging to partition i
+  [[nodiscard]]
+  auto partition(std::size_t i) const noexcept -> std::span<T> {
+    auto const len = data_.size() / partitions_;
+    return data_.subspan(i * len, len);
+  }
+
+  [[nodiscard]]
+  auto active() const noexcept -> bool {
+    return in_flight_;
+  }
+
+  void wait() {
+    check_mpi_result(MPI_Waitall(static_cast<int>(requests_.size()),
+                                 requests_.data(), MPI_STATUSES_IGNORE));
+    in_flight_ = false;
+  }
+
+ protected:
+  partitioned_channel(std::span<T> data,
+                      std::size_t partitions,
+                      int peer,
+                      int tag,
+                      MPI_Comm comm)
+      : data_{data},
+        partitions_{partitions},
+        peer_{peer},
+        tag_{tag},
+        comm_{comm} {
+    if (partitions == 0 || data.size() % partitions != 0) {
+      throw std::invalid_argument(
+          "buffer size must be a non-zero multiple of the partition count");
+    }
+#if defined(CXXMPI_HAS_PARTITIONED_COMMUNICATION)
+    requests_.resize(1, MPI_REQUEST_NULL);
+#else
+    requests_.resize(partitions, MPI_REQUEST_NULL);
+#endif
+  }
+
+  // Elements per partition
+  [[nodiscard]]
+  auto partition_size() const noexcept -> int {
+    return static_cast<int>(data_.size() / partitions_);
+  }
+
+  std::span<T> data_;
+  std::size_t partitions_{};
+  int peer_{MPI_PROC_NULL};
+  int tag_{};
+  MPI_Comm comm_{MPI_COMM_NULL};
+  std::vector<MPI_Request> requests_;
+  bool in_flight_{false};
+
+ private:
+  void release() noexcept {
+    if (in_flight_) {
+      MPI_Waitall(static_cast<int>(requests_.size()), requests_.data(),
+                  MPI_STATUSES_IGNORE);
+      in_flight_ = false;
+    }
+#if defined(CXXMPI_HAS_PARTITIONED_COMMUNICATION)
+    for (auto& req : requests_) {
+      if (req != MPI_REQUEST_NULL) {
+        MPI_Request_free(&req);
+      }
+    }
+#endif
+  }
+};
+
+}  // namespace detail
+
+// Sending side of a partitioned transfer. After start(), worker threads
+// fill their partition() and mark it with pready(); early partitions may be
+// transferred while later ones are still being packed.
+template <typename T>
+class partitioned_send : public detail::partitioned_channel<T> {
+  using base = detail::partitioned_channel<T>;
+
+ public:
+  partitioned_send() = default;
+
+  template <typename Handle>
+  partitioned_send(const basic_comm<Handle>& communicator,
+                   std::span<T> data,
+                   std::size_t partitions,
+                   int dest,
+                   int tag = 0)
+      : base{data, partitions, dest, tag, communicator.native()} {
+#if defined(CXXMPI_HAS_PARTITIONED_COMMUNICATION)
+    check_mpi_result(MPI_Psend_init(
+        this->data_.data(), static_cast<int>(partitions),
+        static_cast<MPI_Count>(this->partition_size()),
+        as_builtin_datatype<T>(), dest, tag, this->comm_, MPI_INFO_NULL,
+        this->requests_.data()));
+#endif
+  }
+
+  void start() {
+#if defined(CXXMPI_HAS_PARTITIONED_COMMUNICATION)
+    check_mpi_result(MPI_Start(this->requests_.data()));
+#endif
+    this->in_flight_ = true;
+  }
+
+  // Marks partition i as packed. May be called concurrently for distinct
+  // partitions under MPI_THREAD_MULTIPLE. Every partition must be marked
+  // before wait().
+  void pready(std::size_t i) {
+#if defined(CXXMPI_HAS_PARTITIONED_COMMUNICATION)
+    check_mpi_result(MPI_Pready(static_cast<int>(i), this->requests_[0]));
+#else
+    check_mpi_result(MPI_Isend(this->partition(i).data(),
+                               this->partition_size(),
+                               as_builtin_datatype<T>(), this->peer_,
+                               this->tag_ + static_cast<int>(i), this->comm_,
+                               &this->requests_[i]));
+#endif
+  }
+};
+
+// Receiving side of a partitioned transfer. After start(), consumers may
+// poll parrived() and use a partition as soon as it has arrived.
+template <typename T>
+class partitioned_recv : public detail::partitioned_channel<T> {
+  using base = detail::partitioned_channel<T>;
+
+ public:
+  partitioned_recv() = default;
+
+  template <typename Handle>
+  partitioned_recv(const basic_comm<Handle>& communicator,
+                   std::span<T> data,
+                   std::size_t partitions,
+                   int source,
+                   int tag = 0)
+      : base{data, partitions, source, tag, communicator.native()} {
+#if defined(CXXMPI_HAS_PARTITIONED_COMMUNICATION)
+    check_mpi_result(MPI_Precv_init(
+        this->data_.data(), static_cast<int>(partitions),
+        static_cast<MPI_Count>(this->partition_size()),
+        as_builtin_datatype<T>(), source, tag, this->comm_, MPI_INFO_NULL,
+        this->requests_.data()));
+#endif
+  }
+
+  void start() {
+#if defined(CXXMPI_HAS_PARTITIONED_COMMUNICATION)
+    check_mpi_result(MPI_Start(this->requests_.data()));
+#else
+    for (std::size_t i = 0; i < this->partitions_; ++i) {
+      check_mpi_result(MPI_Irecv(this->partition(i).data(),
+                                 this->partition_size(),
+                                 as_builtin_datatype<T>(), this->peer_,
+                                 this->tag_ + static_cast<int>(i),
+                                 this->comm_, &this->requests_[i]));
+    }
+#endif
+    this->in_flight_ = true;
+  }
+
+  // Whether partition i has been received. May be called concurrently for
+  // distinct partitions under MPI_THREAD_MULTIPLE.
+  [[nodiscard]]
+  auto parrived(std::size_t i) -> bool {
+    int flag = 0;
+#if defined(CXXMPI_HAS_PARTITIONED_COMMUNICATION)
+    check_mpi_result(
+        MPI_Parrived(this->requests_[0], static_cast<int>(i), &flag));
+#else
+    check_mpi_result(
+        MPI_Test(&this->requests_[i], &flag, MPI_STATUS_IGNORE));
+#endif
+    return flag != 0;
+  }
+};
+
+}  // namespace cxxmpi
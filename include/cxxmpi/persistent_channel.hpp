@@ -0,0 +1,206 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <mpi.h>
+
+#include "cxxmpi/error.hpp"
+#include "cxxmpi/status.hpp"
+
+namespace cxxmpi {
+
+// Persistent point-to-point request created by basic_comm::send_init or
+// basic_comm::recv_init. It stays bound to its buffer, peer and tag and is
+// reused by every start().
+class persistent_channel {
+  MPI_Request request_{MPI_REQUEST_NULL};
+  bool in_flight_{false};
+
+ public:
+  persistent_channel() = default;
+
+  // Takes ownership of an inactive persistent request
+  explicit persistent_channel(MPI_Request req) noexcept : request_{req} {}
+
+  persistent_channel(const persistent_channel&) = delete;
+  auto operator=(const persistent_channel&) -> persistent_channel& = delete;
+
+  persistent_channel(persistent_channel&& other) noexcept
+      : request_{std::exchange(other.request_, MPI_REQUEST_NULL)},
+        in_flight_{std::exchange(other.in_flight_, false)} {}
+
+  auto operator=(persistent_channel&& other) noexcept -> persistent_channel& {
+    if (this != &other) {
+      release();
+      request_ = std::exchange(other.request_, MPI_REQUEST_NULL);
+      in_flight_ = std::exchange(other.in_flight_, false);
+    }
+    return *this;
+  }
+
+  ~persistent_channel() { release(); }
+
+  [[nodiscard]]
+  auto native() const noexcept -> MPI_Request {
+    return request_;
+  }
+
+  // Gives up ownership of the inactive request
+  [[nodiscard]]
+  auto release_native() noexcept -> MPI_Request {
+    return std::exchange(request_, MPI_REQUEST_NULL);
+  }
+
+  [[nodiscard]]
+  auto active() const noexcept -> bool {
+    return in_flight_;
+  }
+
+  void start() {
+    check_mpi_result(MPI_Start(&request_));
+    in_flight_ = true;
+  }
+
+  auto wait() -> status {
+    status st{};
+    check_mpi_result(MPI_Wait(&request_, &st.native()));
+    in_flight_ = false;
+    return st;
+  }
+
+  [[nodiscard]]
+  auto test() -> std::optional<status> {
+    status st{};
+    int flag = 0;
+    check_mpi_result(MPI_Test(&request_, &flag, &st.native()));
+    if (flag == 0) {
+      return std::nullopt;
+    }
+    in_flight_ = false;
+    return st;
+  }
+
+ private:
+  void release() noexcept {
+    if (in_flight_) {
+      MPI_Wait(&request_, MPI_STATUS_IGNORE);
+      in_flight_ = false;
+    }
+    if (request_ != MPI_REQUEST_NULL) {
+      MPI_Request_free(&request_);
+    }
+  }
+};
+
+// Fixed set of persistent channels, e.g. all sends and receives of a halo
+// exchange, started with one MPI_Startall and completed with one
+// MPI_Waitall. The requests are stored contiguously, so an iteration
+// performs no allocation.
+class channel_group {
+  std::vector<MPI_Request> requests_;
+  bool in_flight_{false};
+
+ public:
+  channel_group() = default;
+
+  explicit channel_group(std::size_t reserve_size) {
+    requests_.reserve(reserve_size);
+  }
+
+  channel_group(const channel_group&) = delete;
+  auto operator=(const channel_group&) -> channel_group& = delete;
+
+  channel_group(channel_group&& other) noexcept
+      : requests_{std::move(other.requests_)},
+        in_flight_{std::exchange(other.in_flight_, false)} {}
+
+  auto operator=(channel_group&& other) noexcept -> channel_group& {
+    if (this != &other) {
+      release();
+      requests_ = std::move(other.requests_);
+      in_flight_ = std::exchange(other.in_flight_, false);
+    }
+    return *this;
+  }
+
+  ~channel_group() { release(); }
+
+  // Takes over an inactive channel; returns its index in the group
+  auto add(persistent_channel&& channel) -> std::size_t {
+    if (in_flight_ || channel.active()) {
+      throw std::logic_error("cannot add channels while they are active");
+    }
+    requests_.push_back(channel.release_native());
+    return requests_.size() - 1;
+  }
+
+  [[nodiscard]]
+  auto size() const noexcept -> std::size_t {
+    return requests_.size();
+  }
+
+  [[nodiscard]]
+  auto empty() const noexcept -> bool {
+    return requests_.empty();
+  }
+
+  [[nodiscard]]
+  auto active() const noexcept -> bool {
+    return in_flight_;
+  }
+
+  // An empty group goes through the same start/complete cycle as any
+  // other, so callers need not special-case having no channels
+  void start_all() {
+    if (!empty()) {
+      check_mpi_result(
+          MPI_Startall(static_cast<int>(requests_.size()), requests_.data()));
+    }
+    in_flight_ = true;
+  }
+
+  void wait_all() {
+    if (!empty()) {
+      check_mpi_result(MPI_Waitall(static_cast<int>(requests_.size()),
+                                   requests_.data(), MPI_STATUSES_IGNORE));
+    }
+    in_flight_ = false;
+  }
+
+  [[nodiscard]]
+  auto test_all() -> bool {
+    if (empty()) {
+      in_flight_ = false;
+      return true;
+    }
+    int flag = 0;
+    check_mpi_result(MPI_Testall(static_cast<int>(requests_.size()),
+                                 requests_.data(), &flag,
+                                 MPI_STATUSES_IGNORE));
+    if (flag != 0) {
+      in_flight_ = false;
+    }
+    return flag != 0;
+  }
+
+ private:
+  void release() noexcept {
+    if (in_flight_ && !empty()) {
+      MPI_Waitall(static_cast<int>(requests_.size()), requests_.data(),
+                  MPI_STATUSES_IGNORE);
+    }
+    in_flight_ = false;
+    for (auto& req : requests_) {
+      if (req != MPI_REQUEST_NULL) {
+        MPI_Request_free(&req);
+      }
+    }
+    requests_.clear();
+  }
+};
+
+}  // namespace cxxmpi
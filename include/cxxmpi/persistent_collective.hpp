@@ -0,0 +1,141 @@
+#pragma once
+
+#include <functional>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <mpi.h>
+
+#include "cxxmpi/error.hpp"
+#include "cxxmpi/request.hpp"
+#include "cxxmpi/status.hpp"
+
+namespace cxxmpi {
+
+// A collective bound once to its buffers and arguments that can be started
+// any number of times. Backed by an MPI-4 persistent request when the
+// linked MPI provides one (CXXMPI_HAS_PERSISTENT_COLLECTIVES), otherwise by
+// re-issuing the cached nonblocking call on every start().
+class persistent_collective {
+ public:
+  using start_function = std::function<int(MPI_Request*)>;
+
+  persistent_collective() = default;
+
+  // Takes ownership of an inactive persistent request
+  persistent_collective(MPI_Request req, std::vector<int> args) noexcept
+      : request_{req}, args_{std::move(args)} {}
+
+  // start_fn issues the nonblocking equivalent; args are kept alive for it
+  persistent_collective(start_function start_fn, std::vector<int> args)
+      : start_fn_{std::move(start_fn)}, args_{std::move(args)} {}
+
+  persistent_collective(const persistent_collective&) = delete;
+  auto operator=(const persistent_collective&)
+      -> persistent_collective& = delete;
+
+  persistent_collective(persistent_collective&& other) noexcept
+      : request_{std::exchange(other.request_, MPI_REQUEST_NULL)},
+        start_fn_{std::exchange(other.start_fn_, nullptr)},
+        args_{std::move(other.args_)},
+        in_flight_{std::exchange(other.in_flight_, false)} {}
+
+  auto operator=(persistent_collective&& other) noexcept
+      -> persistent_collective& {
+    if (this != &other) {
+      release();
+      request_ = std::exchange(other.request_, MPI_REQUEST_NULL);
+      start_fn_ = std::exchange(other.start_fn_, nullptr);
+      args_ = std::move(other.args_);
+      in_flight_ = std::exchange(other.in_flight_, false);
+    }
+    return *this;
+  }
+
+  ~persistent_collective() { release(); }
+
+  // Whether this is backed by a native persistent request; false for a
+  // default-constructed or moved-from object, which holds no operation
+  [[nodiscard]]
+  auto persistent() const noexcept -> bool {
+    return !start_fn_ && request_ != MPI_REQUEST_NULL;
+  }
+
+  [[nodiscard]]
+  auto active() const noexcept -> bool {
+    return in_flight_;
+  }
+
+  // Throws std::logic_error if this holds no operation
+  void start() {
+    check_startable();
+    if (persistent()) {
+      check_mpi_result(MPI_Start(&request_));
+    } else {
+      check_mpi_result(start_fn_(&request_));
+    }
+    in_flight_ = true;
+  }
+
+  // Starts the operation and hands its completion over to group. This
+  // object must outlive the group's wait/test on it.
+  void start(request_group& group) {
+    check_startable();
+    if (persistent()) {
+      check_mpi_result(MPI_Start(&request_));
+      group.add() = request_;
+    } else {
+      check_mpi_result(start_fn_(&group.add()));
+    }
+  }
+
+  auto wait() -> status {
+    status st{};
+    check_mpi_result(MPI_Wait(&request_, &st.native()));
+    in_flight_ = false;
+    return st;
+  }
+
+  void wait_without_status() {
+    check_mpi_result(MPI_Wait(&request_, MPI_STATUS_IGNORE));
+    in_flight_ = false;
+  }
+
+  [[nodiscard]]
+  auto test() -> std::optional<status> {
+    status st{};
+    int flag = 0;
+    check_mpi_result(MPI_Test(&request_, &flag, &st.native()));
+    if (flag == 0) {
+      return std::nullopt;
+    }
+    in_flight_ = false;
+    return st;
+  }
+
+ private:
+  void check_startable() const {
+    if (!start_fn_ && request_ == MPI_REQUEST_NULL) {
+      throw std::logic_error("persistent_collective holds no operation");
+    }
+  }
+
+  void release() noexcept {
+    if (in_flight_) {
+      MPI_Wait(&request_, MPI_STATUS_IGNORE);
+      in_flight_ = false;
+    }
+    if (persistent() && request_ != MPI_REQUEST_NULL) {
+      MPI_Request_free(&request_);
+    }
+  }
+
+  MPI_Request request_{MPI_REQUEST_NULL};
+  start_function start_fn_;
+  std::vector<int> args_;
+  bool in_flight_{false};
+};
+
+}  // namespace cxxmpi
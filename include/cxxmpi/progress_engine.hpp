@@ -0,0 +1,241 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <mpi.h>
+
+#include "cxxmpi/error.hpp"
+#include "cxxmpi/request.hpp"
+#include "cxxmpi/status.hpp"
+#include "cxxmpi/universe.hpp"
+
+namespace cxxmpi {
+
+// Polling policy of a progress_engine. After spin_polls unsuccessful polls
+// the thread sleeps, starting at min_sleep and doubling up to max_sleep,
+// until an operation completes or new work is submitted.
+struct progress_options {
+  std::size_t spin_polls{64};
+  std::chrono::microseconds min_sleep{1};
+  std::chrono::microseconds max_sleep{100};
+};
+
+// Background thread that keeps nonblocking operations progressing while
+// the submitting threads compute. Operations are handed over through a
+// lock-free multi-producer queue and completed with MPI_Testsome; the
+// completion callback runs on the engine thread. Requires
+// MPI_THREAD_MULTIPLE.
+class progress_engine {
+ public:
+  using callback = std::function<void(const status&)>;
+
+  explicit progress_engine(progress_options options = {})
+      : options_{options} {
+    if (universe::thread_level() < MPI_THREAD_MULTIPLE) {
+      throw std::logic_error("progress_engine requires MPI_THREAD_MULTIPLE");
+    }
+    thread_ = std::thread{[this] { run(); }};
+  }
+
+  progress_engine(const progress_engine&) = delete;
+  auto operator=(const progress_engine&) -> progress_engine& = delete;
+  progress_engine(progress_engine&&) = delete;
+  auto operator=(progress_engine&&) -> progress_engine& = delete;
+
+  // Completes all submitted operations before returning
+  ~progress_engine() { join(); }
+
+  // Thread-safe. The request is kept alive until completion. An inactive
+  // request completes immediately on the calling thread.
+  void submit(request&& req, callback on_complete = {}) {
+    if (!req.active()) {
+      if (on_complete) {
+        on_complete(status{});
+      }
+      return;
+    }
+    auto* node = new submission{std::move(req), std::move(on_complete)};
+    pending_.fetch_add(1, std::memory_order_relaxed);
+    node->next = inbox_.load(std::memory_order_relaxed);
+    while (!inbox_.compare_exchange_weak(node->next, node,
+                                         std::memory_order_release,
+                                         std::memory_order_relaxed)) {
+    }
+    wake();
+  }
+
+  // Number of submitted operations whose callback has not finished
+  [[nodiscard]]
+  auto pending() const noexcept -> std::size_t {
+    return pending_.load(std::memory_order_acquire);
+  }
+
+  // Blocks until every operation submitted so far has completed
+  void wait_idle() const noexcept {
+    for (auto n = pending(); n != 0; n = pending()) {
+      pending_.wait(n, std::memory_order_acquire);
+    }
+  }
+
+  // Completes the outstanding operations and stops the thread. Rethrows
+  // the first exception thrown by a callback.
+  void stop() {
+    join();
+    if (error_) {
+      std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+  }
+
+ private:
+  struct submission {
+    request req;
+    callback on_complete;
+    submission* next{nullptr};
+  };
+
+  progress_options options_;
+  std::atomic<submission*> inbox_{nullptr};
+  std::atomic<std::uint32_t> wakeups_{0};
+  mutable std::atomic<std::size_t> pending_{0};
+  std::atomic<bool> stopping_{false};
+  std::exception_ptr error_;
+  std::thread thread_;
+
+  // Owned by the engine thread
+  std::vector<MPI_Request> requests_;
+  std::vector<std::unique_ptr<submission>> submissions_;
+  std::vector<int> indices_;
+  std::vector<MPI_Status> statuses_;
+
+  void wake() noexcept {
+    wakeups_.fetch_add(1, std::memory_order_release);
+    wakeups_.notify_one();
+  }
+
+  void join() noexcept {
+    if (thread_.joinable()) {
+      stopping_.store(true, std::memory_order_release);
+      wake();
+      thread_.join();
+    }
+  }
+
+  // Moves the submitted operations into the polled arrays in submission
+  // order
+  auto drain_inbox() -> bool {
+    auto* node = inbox_.exchange(nullptr, std::memory_order_acquire);
+    if (node == nullptr) {
+      return false;
+    }
+    auto const first = submissions_.size();
+    for (; node != nullptr; node = node->next) {
+      submissions_.emplace_back(node);
+    }
+    std::reverse(submissions_.begin() + static_cast<std::ptrdiff_t>(first),
+                 submissions_.end());
+    for (auto i = first; i < submissions_.size(); ++i) {
+      requests_.push_back(submissions_[i]->req.native());
+    }
+    return true;
+  }
+
+  // Returns the number of completed operations
+  auto poll() -> std::size_t {
+    if (requests_.empty()) {
+      return 0;
+    }
+    indices_.resize(requests_.size());
+    statuses_.resize(requests_.size());
+    int outcount = 0;
+    check_mpi_result(MPI_Testsome(static_cast<int>(requests_.size()),
+                                  requests_.data(), &outcount,
+                                  indices_.data(), statuses_.data()));
+    if (outcount == MPI_UNDEFINED || outcount == 0) {
+      return 0;
+    }
+
+    auto const done = static_cast<std::size_t>(outcount);
+    for (std::size_t i = 0; i < done; ++i) {
+      auto& slot = submissions_[static_cast<std::size_t>(indices_[i])];
+      // A completed persistent request stays a valid inactive handle,
+      // owned by whoever created it; the slot is retired either way
+      slot->req.native() = MPI_REQUEST_NULL;
+      if (slot->on_complete) {
+        status st{};
+        st.native() = statuses_[i];
+        try {
+          slot->on_complete(st);
+        } catch (...) {
+          if (!error_) {
+            error_ = std::current_exception();
+          }
+        }
+      }
+      slot.reset();
+    }
+
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < requests_.size(); ++i) {
+      if (submissions_[i]) {
+        requests_[kept] = requests_[i];
+        submissions_[kept] = std::move(submissions_[i]);
+        ++kept;
+      }
+    }
+    requests_.resize(kept);
+    submissions_.resize(kept);
+
+    pending_.fetch_sub(done, std::memory_order_release);
+    pending_.notify_all();
+    return done;
+  }
+
+  void run() noexcept {
+    std::size_t idle_polls = 0;
+    auto sleep = options_.min_sleep;
+    while (true) {
+      auto const seen = wakeups_.load(std::memory_order_acquire);
+      auto const submitted = drain_inbox();
+      std::size_t done = 0;
+      try {
+        done = poll();
+      } catch (...) {
+        if (!error_) {
+          error_ = std::current_exception();
+        }
+      }
+
+      if (submitted || done > 0) {
+        idle_polls = 0;
+        sleep = options_.min_sleep;
+        continue;
+      }
+      if (requests_.empty()) {
+        if (stopping_.load(std::memory_order_acquire)) {
+          return;
+        }
+        // Nothing to progress: block until the next submit or stop
+        wakeups_.wait(seen, std::memory_order_acquire);
+        continue;
+      }
+      if (++idle_polls <= options_.spin_polls) {
+        continue;
+      }
+      std::this_thread::sleep_for(sleep);
+      sleep = std::min(sleep * 2, options_.max_sleep);
+    }
+  }
+};
+
+}  // namespace cxxmpi
@@ -1,6 +1,14 @@
 #pragma once
 
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <new>
 #include <optional>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <mpi.h>
@@ -9,8 +17,352 @@
 #include "cxxmpi/status.hpp"
 
 namespace cxxmpi {
+
+// Owning handle to one nonblocking operation. Count and displacement arrays
+// the operation reads from are kept alive alongside the MPI_Request, and
+// an operation still in flight is waited for on destruction, or cancelled
+// first if cancel_on_destroy() was requested.
+class request {
+  MPI_Request request_{MPI_REQUEST_NULL};
+  std::vector<int> args_;
+  bool cancel_on_destroy_{false};
+
+ public:
+  request() = default;
+
+  explicit request(MPI_Request req) noexcept : request_{req} {}
+
+  // args must be the storage the operation was started with; moving a
+  // std::vector keeps its buffer in place
+  request(MPI_Request req, std::vector<int> args) noexcept
+      : request_{req}, args_{std::move(args)} {}
+
+  request(const request&) = delete;
+  auto operator=(const request&) -> request& = delete;
+
+  request(request&& other) noexcept
+      : request_{std::exchange(other.request_, MPI_REQUEST_NULL)},
+        args_{std::move(other.args_)},
+        cancel_on_destroy_{other.cancel_on_destroy_} {}
+
+  auto operator=(request&& other) noexcept -> request& {
+    if (this != &other) {
+      complete();
+      request_ = std::exchange(other.request_, MPI_REQUEST_NULL);
+      args_ = std::move(other.args_);
+      cancel_on_destroy_ = other.cancel_on_destroy_;
+    }
+    return *this;
+  }
+
+  ~request() { complete(); }
+
+  // Whether the operation has not been completed through this handle yet
+  [[nodiscard]]
+  auto active() const noexcept -> bool {
+    return request_ != MPI_REQUEST_NULL;
+  }
+
+  [[nodiscard]]
+  auto native() noexcept -> MPI_Request& {
+    return request_;
+  }
+
+  [[nodiscard]]
+  auto native() const noexcept -> MPI_Request {
+    return request_;
+  }
+
+  auto wait() -> status {
+    status st{};
+    check_mpi_result(MPI_Wait(&request_, &st.native()));
+    return st;
+  }
+
+  void wait_without_status() {
+    check_mpi_result(MPI_Wait(&request_, MPI_STATUS_IGNORE));
+  }
+
+  [[nodiscard]]
+  auto test() -> std::optional<status> {
+    status st{};
+    int flag = 0;
+    check_mpi_result(MPI_Test(&request_, &flag, &st.native()));
+    if (flag == 0) {
+      return std::nullopt;
+    }
+    return st;
+  }
+
+  // Requests cancellation and waits until the operation either completed
+  // or was cancelled; status::cancelled() tells which
+  auto cancel() -> status {
+    status st{};
+    if (active()) {
+      check_mpi_result(MPI_Cancel(&request_));
+      check_mpi_result(MPI_Wait(&request_, &st.native()));
+    }
+    return st;
+  }
+
+  // Whether an operation still in flight on destruction is cancelled
+  // instead of waited for, e.g. a speculative receive
+  void cancel_on_destroy(bool enable = true) noexcept {
+    cancel_on_destroy_ = enable;
+  }
+
+ private:
+  void complete() noexcept {
+    if (active()) {
+      if (cancel_on_destroy_) {
+        MPI_Cancel(&request_);
+      }
+      MPI_Wait(&request_, MPI_STATUS_IGNORE);
+    }
+  }
+};
+
+// A request that owns the buffer of its operation, e.g. the std::vector an
+// irecv writes into. The buffer cannot be touched before completion and is
+// handed back by get().
+template <typename T>
+class future {
+  // Declared before request_ so the operation completes before the buffer
+  // is destroyed
+  T value_;
+  request request_;
+
+ public:
+  future() = default;
+
+  // value must already be the buffer the operation was started on; moving
+  // a std::vector keeps its storage in place
+  future(T value, request req) noexcept
+      : value_{std::move(value)}, request_{std::move(req)} {}
+
+  [[nodiscard]]
+  auto valid() const noexcept -> bool {
+    return request_.active();
+  }
+
+  [[nodiscard]]
+  auto native() noexcept -> MPI_Request& {
+    return request_.native();
+  }
+
+  auto wait() -> status { return request_.wait(); }
+
+  [[nodiscard]]
+  auto test() -> std::optional<status> {
+    return request_.test();
+  }
+
+  // Waits for completion and returns the buffer
+  [[nodiscard]]
+  auto get() -> T {
+    request_.wait_without_status();
+    return std::move(value_);
+  }
+
+  auto cancel() -> status { return request_.cancel(); }
+
+  void cancel_on_destroy(bool enable = true) noexcept {
+    request_.cancel_on_destroy(enable);
+  }
+};
+
+// Callable run when a request of a request_group completes. Callables of
+// up to inline_size bytes are stored in place; larger ones are allocated.
+class completion_handler {
+ public:
+  static constexpr size_t inline_size = 32;
+
+  completion_handler() = default;
+
+  template <typename Fn>
+    requires(!std::same_as<std::remove_cvref_t<Fn>, completion_handler>
+             && std::invocable<std::remove_cvref_t<Fn>&, const status&>)
+  // NOLINTNEXTLINE
+  completion_handler(Fn&& fn) {
+    using fn_type = std::remove_cvref_t<Fn>;
+    if constexpr (stored_inline<fn_type>) {
+      ::new (static_cast<void*>(storage_)) fn_type(std::forward<Fn>(fn));
+      vtable_ = &inline_vtable<fn_type>;
+    } else {
+      ::new (static_cast<void*>(storage_))
+          fn_type*(new fn_type(std::forward<Fn>(fn)));
+      vtable_ = &heap_vtable<fn_type>;
+    }
+  }
+
+  completion_handler(const completion_handler&) = delete;
+  auto operator=(const completion_handler&) -> completion_handler& = delete;
+
+  completion_handler(completion_handler&& other) noexcept
+      : vtable_{std::exchange(other.vtable_, nullptr)} {
+    if (vtable_ != nullptr) {
+      vtable_->move(storage_, other.storage_);
+    }
+  }
+
+  auto operator=(completion_handler&& other) noexcept
+      -> completion_handler& {
+    if (this != &other) {
+      reset();
+      vtable_ = std::exchange(other.vtable_, nullptr);
+      if (vtable_ != nullptr) {
+        vtable_->move(storage_, other.storage_);
+      }
+    }
+    return *this;
+  }
+
+  ~completion_handler() { reset(); }
+
+  [[nodiscard]]
+  explicit operator bool() const noexcept {
+    return vtable_ != nullptr;
+  }
+
+  void operator()(const status& st) { vtable_->invoke(storage_, st); }
+
+ private:
+  struct vtable {
+    void (*invoke)(void*, const status&);
+    // Move-constructs into dst and destroys src
+    void (*move)(void* dst, void* src) noexcept;
+    void (*destroy)(void*) noexcept;
+  };
+
+  template <typename Fn>
+  static constexpr bool stored_inline =
+      sizeof(Fn) <= inline_size && alignof(Fn) <= alignof(std::max_align_t)
+      && std::is_nothrow_move_constructible_v<Fn>;
+
+  template <typename Fn>
+  static constexpr vtable inline_vtable = {
+      [](void* p, const status& st) { (*static_cast<Fn*>(p))(st); },
+      [](void* dst, void* src) noexcept {
+        ::new (dst) Fn(std::move(*static_cast<Fn*>(src)));
+        static_cast<Fn*>(src)->~Fn();
+      },
+      [](void* p) noexcept { static_cast<Fn*>(p)->~Fn(); }};
+
+  template <typename Fn>
+  static constexpr vtable heap_vtable = {
+      [](void* p, const status& st) { (**static_cast<Fn**>(p))(st); },
+      [](void* dst, void* src) noexcept {
+        ::new (dst) Fn*(*static_cast<Fn**>(src));
+      },
+      [](void* p) noexcept { delete *static_cast<Fn**>(p); }};
+
+  void reset() noexcept {
+    if (vtable_ != nullptr) {
+      std::exchange(vtable_, nullptr)->destroy(storage_);
+    }
+  }
+
+  alignas(std::max_align_t) std::byte storage_[inline_size]{};  // NOLINT
+  const vtable* vtable_{nullptr};
+};
+
+// One entry of a wait_some/test_some result
+struct completion {
+  size_t index;
+  status st;
+};
+
+// Completions retired by one wait_some/test_some call. Views the group's
+// recycled buffers and stays valid until the next call on the group.
+class completion_range {
+  const int* indices_{nullptr};
+  const status* statuses_{nullptr};
+  size_t size_{0};
+
+ public:
+  class iterator {
+    const completion_range* range_{nullptr};
+    size_t pos_{0};
+
+   public:
+    using value_type = completion;
+    using difference_type = std::ptrdiff_t;
+
+    iterator() = default;
+    iterator(const completion_range* range, size_t pos) noexcept
+        : range_{range}, pos_{pos} {}
+
+    auto operator*() const noexcept -> completion { return (*range_)[pos_]; }
+
+    auto operator++() noexcept -> iterator& {
+      ++pos_;
+      return *this;
+    }
+
+    auto operator++(int) noexcept -> iterator {
+      auto prev = *this;
+      ++pos_;
+      return prev;
+    }
+
+    friend auto operator==(const iterator& l, const iterator& r) noexcept
+        -> bool {
+      return l.pos_ == r.pos_;
+    }
+  };
+
+  completion_range() = default;
+
+  completion_range(const int* indices,
+                   const status* statuses,
+                   size_t size) noexcept
+      : indices_{indices}, statuses_{statuses}, size_{size} {}
+
+  [[nodiscard]]
+  auto size() const noexcept -> size_t {
+    return size_;
+  }
+
+  [[nodiscard]]
+  auto empty() const noexcept -> bool {
+    return size_ == 0;
+  }
+
+  [[nodiscard]]
+  auto operator[](size_t i) const noexcept -> completion {
+    return {static_cast<size_t>(indices_[i]), statuses_[i]};  // NOLINT
+  }
+
+  [[nodiscard]]
+  auto begin() const noexcept -> iterator {
+    return {this, 0};
+  }
+
+  [[nodiscard]]
+  auto end() const noexcept -> iterator {
+    return {this, size_};
+  }
+};
+
+// Requests completed together. Completed slots are MPI_REQUEST_NULL and
+// keep their index. wait_all/test_all and wait_some/test_some reset the
+// group to empty once its last active request completes; wait_any/test_any
+// only null the slot, so the group keeps its size until one of those runs.
+//
+// A request may carry a completion_handler that the completing wait/test
+// call runs after retiring it. Handlers may add() new requests to the
+// group, e.g. to re-post a receive as soon as the previous one completed.
 class request_group {
+  using ready_list = std::vector<std::pair<completion_handler, status>>;
+
   std::vector<MPI_Request> requests_;
+  std::vector<completion_handler> handlers_;
+  size_t active_{0};
+  size_t handler_count_{0};
+  // Recycled by wait_some/test_some
+  std::vector<int> indices_;
+  std::vector<status> statuses_;
+  ready_list ready_;
 
  public:
   request_group() = default;
@@ -22,6 +374,20 @@ class request_group {
   [[nodiscard]]
   auto add() -> MPI_Request& {
     requests_.push_back(MPI_REQUEST_NULL);
+    ++active_;
+    return requests_.back();
+  }
+
+  // on_complete(const status&) runs when the request is retired
+  template <typename Fn>
+    requires std::invocable<std::remove_cvref_t<Fn>&, const status&>
+  [[nodiscard]]
+  auto add(Fn&& on_complete) -> MPI_Request& {
+    handlers_.resize(requests_.size());
+    handlers_.emplace_back(std::forward<Fn>(on_complete));
+    requests_.push_back(MPI_REQUEST_NULL);
+    ++active_;
+    ++handler_count_;
     return requests_.back();
   }
 
@@ -55,28 +421,45 @@ class request_group {
     return requests_.empty();
   }
 
+  // Number of added requests that have not been retired yet
+  [[nodiscard]]
+  auto active() const noexcept -> size_t {
+    return active_;
+  }
+
   void wait_all_without_status() {
     if (empty()) {
       return;
     }
 
+    if (handler_count_ > 0) {
+      wait_all(statuses_);
+      return;
+    }
     check_mpi_result(MPI_Waitall(static_cast<int>(requests_.size()),
                                  requests_.data(), MPI_STATUSES_IGNORE));
-    requests_.clear();
+    reset();
   }
 
   [[nodiscard]]
   auto wait_all() -> std::vector<status> {
+    std::vector<status> statuses;
+    wait_all(statuses);
+    return statuses;
+  }
+
+  // Reuses the capacity of statuses across calls
+  void wait_all(std::vector<status>& statuses) {
     if (empty()) {
-      return {};
+      statuses.clear();
+      return;
     }
 
-    std::vector<status> statuses(requests_.size());
+    statuses.resize(requests_.size());
     check_mpi_result(
         MPI_Waitall(static_cast<int>(requests_.size()), requests_.data(),
                     reinterpret_cast<MPI_Status*>(statuses.data())));
-    requests_.clear();
-    return statuses;
+    complete_all(statuses);
   }
 
   [[nodiscard]]
@@ -92,23 +475,58 @@ class request_group {
 
     if (index >= 0) {
       requests_[static_cast<size_t>(index)] = MPI_REQUEST_NULL;
+      complete(std::span<const int>{&index, 1}, std::span{&st, 1}, false);
     }
 
     return {static_cast<size_t>(index), st};
   }
 
+  // Blocks until at least one request completes and retires every request
+  // that has completed by then
+  [[nodiscard]]
+  auto wait_some() -> completion_range {
+    prepare_buffers();
+    auto const n = wait_some(std::span{indices_}, std::span{statuses_});
+    return {indices_.data(), statuses_.data(), n};
+  }
+
+  // Like wait_some() but returns an empty range instead of blocking
+  [[nodiscard]]
+  auto test_some() -> completion_range {
+    prepare_buffers();
+    auto const n = test_some(std::span{indices_}, std::span{statuses_});
+    return {indices_.data(), statuses_.data(), n};
+  }
+
+  // Caller-owned buffers, each with at least size() entries. Returns the
+  // number of completions written.
+  [[nodiscard]]
+  auto wait_some(std::span<int> indices, std::span<status> statuses)
+      -> size_t {
+    return some(indices, statuses, true);
+  }
+
+  [[nodiscard]]
+  auto test_some(std::span<int> indices, std::span<status> statuses)
+      -> size_t {
+    return some(indices, statuses, false);
+  }
+
   [[nodiscard]]
   auto test_all_without_status() -> bool {
     if (empty()) {
       return true;
     }
 
+    if (handler_count_ > 0) {
+      return test_all(statuses_);
+    }
     int flag = 0;
     check_mpi_result(MPI_Testall(static_cast<int>(requests_.size()),
                                  requests_.data(), &flag, MPI_STATUSES_IGNORE));
 
     if (flag != 0) {
-      requests_.clear();
+      reset();
       return true;
     }
     return false;
@@ -128,7 +546,7 @@ class request_group {
                     reinterpret_cast<MPI_Status*>(statuses.data())));
 
     if (flag != 0) {
-      requests_.clear();
+      complete_all(statuses);
       return true;
     }
     return false;
@@ -147,10 +565,111 @@ class request_group {
 
     if ((flag != 0) && (index >= 0)) {
       requests_[static_cast<size_t>(index)] = MPI_REQUEST_NULL;
+      complete(std::span<const int>{&index, 1}, std::span{&st, 1}, false);
       return static_cast<size_t>(index);
     }
     return std::nullopt;
   }
+
+ private:
+  // Requests are trivially destructible, so clearing does not touch the
+  // slots. handlers_ only extends up to the last slot given a handler.
+  void reset() noexcept {
+    requests_.clear();
+    handlers_.clear();
+    handler_count_ = 0;
+    active_ = 0;
+  }
+
+  void retire(size_t n, bool recycle) noexcept {
+    active_ = n < active_ ? active_ - n : 0;
+    if (recycle && active_ == 0) {
+      reset();
+    }
+  }
+
+  // Retires the completed slots, then runs their handlers. Handlers are
+  // moved out first since they may add requests and reallocate the slots.
+  // recycle resets the group once no active request is left.
+  void complete(std::span<const int> indices,
+                std::span<const status> sts,
+                bool recycle) {
+    if (handler_count_ == 0) {
+      retire(indices.size(), recycle);
+      return;
+    }
+    auto ready = std::move(ready_);
+    ready.clear();
+    for (size_t i = 0; i < indices.size(); ++i) {
+      auto const index = static_cast<size_t>(indices[i]);
+      if (index < handlers_.size() && handlers_[index]) {
+        ready.emplace_back(std::move(handlers_[index]), sts[i]);
+        --handler_count_;
+      }
+    }
+    retire(indices.size(), recycle);
+    run(ready);
+  }
+
+  void complete_all(std::span<const status> sts) {
+    if (handler_count_ == 0) {
+      reset();
+      return;
+    }
+    auto ready = std::move(ready_);
+    ready.clear();
+    for (size_t i = 0; i < handlers_.size(); ++i) {
+      if (handlers_[i]) {
+        ready.emplace_back(std::move(handlers_[i]), sts[i]);
+      }
+    }
+    reset();
+    run(ready);
+  }
+
+  void run(ready_list& ready) {
+    for (auto& [handler, st] : ready) {
+      handler(st);
+    }
+    ready.clear();
+    ready_ = std::move(ready);
+  }
+
+  void prepare_buffers() {
+    if (indices_.size() < requests_.size()) {
+      indices_.resize(requests_.size());
+      statuses_.resize(requests_.size());
+    }
+  }
+
+  auto some(std::span<int> indices, std::span<status> statuses, bool blocking)
+      -> size_t {
+    if (empty()) {
+      return 0;
+    }
+    assert(indices.size() >= requests_.size());
+    assert(statuses.size() >= requests_.size());
+
+    auto const n = static_cast<int>(requests_.size());
+    auto* native_statuses = reinterpret_cast<MPI_Status*>(statuses.data());
+    int outcount = 0;
+    if (blocking) {
+      check_mpi_result(MPI_Waitsome(n, requests_.data(), &outcount,
+                                    indices.data(), native_statuses));
+    } else {
+      check_mpi_result(MPI_Testsome(n, requests_.data(), &outcount,
+                                    indices.data(), native_statuses));
+    }
+
+    // No active request was left in the group
+    if (outcount == MPI_UNDEFINED) {
+      reset();
+      return 0;
+    }
+    auto const done = static_cast<size_t>(outcount);
+    complete(indices.first(done), statuses.first(done), true);
+    return done;
+  }
 };
 
 }  // namespace cxxmpi
@@ -51,6 +51,14 @@ class status {
     check_mpi_result(MPI_Get_count(&status_, wdtype.native(), &count));
     return count;
   }
+
+  // Whether the operation this status belongs to was cancelled
+  [[nodiscard]]
+  auto cancelled() const -> bool {
+    int flag = 0;
+    check_mpi_result(MPI_Test_cancelled(&status_, &flag));
+    return flag != 0;
+  }
 };
 
 }  // namespace cxxmpi
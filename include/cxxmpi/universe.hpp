@@ -71,6 +71,15 @@ class universe {
     return flag != 0;
   }
 
+  // Thread support level provided by the MPI library, e.g.
+  // MPI_THREAD_MULTIPLE
+  [[nodiscard]]
+  static auto thread_level() -> int {
+    int provided = MPI_THREAD_SINGLE;
+    check_mpi_result(MPI_Query_thread(&provided));
+    return provided;
+  }
+
   [[nodiscard]]
   static auto is_thread_main() -> bool {
     int flag = 0;
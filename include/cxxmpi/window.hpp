@@ -0,0 +1,509 @@
+#pragma once
+
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <mpi.h>
+
+#include "cxxmpi/comm.hpp"
+#include "cxxmpi/dtype.hpp"
+#include "cxxmpi/error.hpp"
+#include "cxxmpi/op.hpp"
+
+namespace cxxmpi {
+
+class weak_win_handle {
+  MPI_Win win_{MPI_WIN_NULL};
+
+ public:
+  constexpr weak_win_handle() noexcept = default;
+  // NOLINTNEXTLINE
+  weak_win_handle(std::nullptr_t) noexcept {}
+  // NOLINTNEXTLINE
+  constexpr weak_win_handle(MPI_Win win) noexcept : win_{win} {}
+
+  [[nodiscard]]
+  explicit operator bool() const noexcept {
+    return win_ != MPI_WIN_NULL;
+  }
+
+  // Smart reference pattern
+  [[nodiscard]]
+  constexpr auto operator->() noexcept -> weak_win_handle* {
+    return this;
+  }
+  [[nodiscard]]
+  constexpr auto operator->() const noexcept -> const weak_win_handle* {
+    return this;
+  }
+
+  [[nodiscard]]
+  constexpr auto native() noexcept -> MPI_Win& {
+    return win_;
+  }
+
+  [[nodiscard]]
+  constexpr auto native() const noexcept -> MPI_Win {
+    return win_;
+  }
+
+  [[nodiscard]]
+  auto release() noexcept -> MPI_Win {
+    return std::exchange(win_, MPI_WIN_NULL);
+  }
+
+  constexpr friend auto operator==(const weak_win_handle& l,
+                                   const weak_win_handle& r) noexcept
+      -> bool {
+    return l.win_ == r.win_;
+  }
+
+  constexpr friend auto operator!=(const weak_win_handle& l,
+                                   const weak_win_handle& r) noexcept
+      -> bool {
+    return !(l == r);
+  }
+};
+
+namespace detail {
+struct win_deleter {
+  using pointer = weak_win_handle;
+
+  void operator()(weak_win_handle handle) const noexcept {
+    if (handle) {
+      MPI_Win win = handle.release();
+      MPI_Win_free(&win);
+    }
+  }
+};
+}  // namespace detail
+
+using win_handle = std::unique_ptr<weak_win_handle, detail::win_deleter>;
+
+// Node-local memory allocated with MPI_Win_allocate_shared. Every process
+// of the (shared-memory) communicator contributes a segment and can access
+// the segments of all others through plain loads and stores, e.g. to keep a
+// single copy of a read-only table per node:
+//
+//   auto node = comm_world().split_type(split_kind::shared);
+//   auto table = shared_window<double>{node, node.rank() == 0 ? n : 0};
+//   if (node.rank() == 0) { fill(table.local()); }
+//   table.fence();
+//   use(table.segment(0));
+//
+// Accesses by different processes must be separated by synchronization,
+// such as fence().
+template <typename T>
+  requires std::is_trivially_copyable_v<T>
+class shared_window {
+ public:
+  shared_window() = default;
+
+  // Collective over communicator, which must be a shared-memory one (see
+  // basic_comm::split_type); count is the size of this process's segment
+  template <typename Handle>
+  shared_window(const basic_comm<Handle>& communicator, std::size_t count)
+      : handle_{allocate(communicator, count)} {
+    segments_.reserve(communicator.size());
+    for (int r = 0; r < static_cast<int>(communicator.size()); ++r) {
+      segments_.push_back(query(r));
+    }
+    local_ = segments_[static_cast<std::size_t>(communicator.rank())];
+  }
+
+  [[nodiscard]]
+  auto native() const noexcept -> MPI_Win {
+    return handle_->native();
+  }
+
+  // Segment of this process
+  [[nodiscard]]
+  auto local() const noexcept -> std::span<T> {
+    return local_;
+  }
+
+  // Segment of rank, addressable by this process
+  [[nodiscard]]
+  auto segment(int rank) const noexcept -> std::span<T> {
+    return segments_[static_cast<std::size_t>(rank)];
+  }
+
+  [[nodiscard]]
+  auto segments() const noexcept -> std::span<const std::span<T>> {
+    return segments_;
+  }
+
+  // Completes all accesses and makes them visible to every process
+  void fence(int assertions = 0) const {
+    check_mpi_result(MPI_Win_fence(assertions, native()));
+  }
+
+ private:
+  win_handle handle_;
+  std::span<T> local_;
+  std::vector<std::span<T>> segments_;
+
+  template <typename Handle>
+  static auto allocate(const basic_comm<Handle>& communicator,
+                       std::size_t count) -> win_handle {
+    void* base = nullptr;
+    weak_win_handle win;
+    check_mpi_result(MPI_Win_allocate_shared(
+        static_cast<MPI_Aint>(count * sizeof(T)), static_cast<int>(sizeof(T)),
+        MPI_INFO_NULL, communicator.native(), &base, &win.native()));
+    return win_handle{win};
+  }
+
+  [[nodiscard]]
+  auto query(int rank) const -> std::span<T> {
+    MPI_Aint bytes = 0;
+    int disp_unit = 0;
+    void* base = nullptr;
+    check_mpi_result(
+        MPI_Win_shared_query(native(), rank, &bytes, &disp_unit, &base));
+    return {static_cast<T*>(base),
+            static_cast<std::size_t>(bytes) / sizeof(T)};
+  }
+};
+
+// Operators valid for one-sided accumulation: the predefined reductions,
+// plus MPI_REPLACE and MPI_NO_OP passed as MPI_Op
+template <typename Op>
+concept accumulate_op =
+    builtin_op<Op> || std::same_as<std::remove_cvref_t<Op>, MPI_Op>;
+
+enum class lock_type : int {
+  exclusive = MPI_LOCK_EXCLUSIVE,
+  shared = MPI_LOCK_SHARED,
+};
+
+// RMA synchronization epoch opened by one of the window<T> epoch functions
+// and closed by close() or the destructor, so that every one-sided
+// operation issued in it has completed when the guard goes away. close()
+// reports errors; the destructor cannot and ignores them.
+class rma_epoch {
+ public:
+  enum class kind : std::uint8_t {
+    fence,
+    access,
+    exposure,
+    lock,
+    lock_all,
+  };
+
+  rma_epoch() = default;
+
+  // Takes over an epoch already opened on win
+  rma_epoch(MPI_Win win, kind epoch_kind, int rank = MPI_PROC_NULL) noexcept
+      : win_{win}, kind_{epoch_kind}, rank_{rank} {}
+
+  rma_epoch(const rma_epoch&) = delete;
+  auto operator=(const rma_epoch&) -> rma_epoch& = delete;
+
+  rma_epoch(rma_epoch&& other) noexcept
+      : win_{std::exchange(other.win_, MPI_WIN_NULL)},
+        kind_{other.kind_},
+        rank_{other.rank_} {}
+
+  auto operator=(rma_epoch&& other) noexcept -> rma_epoch& {
+    if (this != &other) {
+      finish();
+      win_ = std::exchange(other.win_, MPI_WIN_NULL);
+      kind_ = other.kind_;
+      rank_ = other.rank_;
+    }
+    return *this;
+  }
+
+  ~rma_epoch() { finish(); }
+
+  [[nodiscard]]
+  auto open() const noexcept -> bool {
+    return win_ != MPI_WIN_NULL;
+  }
+
+  void close() { check_mpi_result(finish()); }
+
+  // Completes the operations issued so far to rank, at origin and target;
+  // passive-target epochs only
+  void flush(int rank) const {
+    check_mpi_result(MPI_Win_flush(rank, win_));
+  }
+
+  void flush_all() const { check_mpi_result(MPI_Win_flush_all(win_)); }
+
+  // Completes the operations issued so far to rank at the origin only, so
+  // their buffers can be reused
+  void flush_local(int rank) const {
+    check_mpi_result(MPI_Win_flush_local(rank, win_));
+  }
+
+ private:
+  MPI_Win win_{MPI_WIN_NULL};
+  kind kind_{kind::fence};
+  int rank_{MPI_PROC_NULL};
+
+  auto finish() noexcept -> int {
+    if (win_ == MPI_WIN_NULL) {
+      return MPI_SUCCESS;
+    }
+    auto const win = std::exchange(win_, MPI_WIN_NULL);
+    switch (kind_) {
+      case kind::fence:
+        return MPI_Win_fence(MPI_MODE_NOSUCCEED, win);
+      case kind::access:
+        return MPI_Win_complete(win);
+      case kind::exposure:
+        return MPI_Win_wait(win);
+      case kind::lock:
+        return MPI_Win_unlock(rank_, win);
+      case kind::lock_all:
+        return MPI_Win_unlock_all(win);
+    }
+    return MPI_SUCCESS;
+  }
+};
+
+// Owning one-sided communication window over elements of T. The target
+// displacement of every operation counts elements of T, except in a
+// dynamic window, where it is an address obtained with address() on the
+// target. Operations are nonblocking and complete with the epoch they are
+// issued in (or a flush), so their buffers must stay untouched until then.
+template <typename T>
+  requires has_builtin_datatype<T>
+class window {
+ public:
+  window() = default;
+
+  // MPI_Win_allocate: MPI provides count elements per process, which
+  // permits the fastest RMA path on some networks. Collective.
+  template <typename Handle>
+  window(const basic_comm<Handle>& communicator, std::size_t count) {
+    void* base = nullptr;
+    weak_win_handle win;
+    check_mpi_result(MPI_Win_allocate(
+        static_cast<MPI_Aint>(count * sizeof(T)), static_cast<int>(sizeof(T)),
+        MPI_INFO_NULL, communicator.native(), &base, &win.native()));
+    handle_ = win_handle{win};
+    local_ = {static_cast<T*>(base), count};
+  }
+
+  // MPI_Win_create: exposes memory owned by the caller, which must outlive
+  // the window. Collective.
+  template <typename Handle, size_t Extent>
+  window(const basic_comm<Handle>& communicator, std::span<T, Extent> memory)
+      : local_{memory} {
+    weak_win_handle win;
+    check_mpi_result(MPI_Win_create(
+        memory.data(), static_cast<MPI_Aint>(memory.size_bytes()),
+        static_cast<int>(sizeof(T)), MPI_INFO_NULL, communicator.native(),
+        &win.native()));
+    handle_ = win_handle{win};
+  }
+
+  // MPI_Win_create_dynamic: memory is attached and detached later.
+  // Collective.
+  template <typename Handle>
+  explicit window(const basic_comm<Handle>& communicator) {
+    weak_win_handle win;
+    check_mpi_result(MPI_Win_create_dynamic(
+        MPI_INFO_NULL, communicator.native(), &win.native()));
+    handle_ = win_handle{win};
+  }
+
+  [[nodiscard]]
+  auto native() const noexcept -> MPI_Win {
+    return handle_->native();
+  }
+
+  // Memory of this process; empty for a dynamic window
+  [[nodiscard]]
+  auto local() const noexcept -> std::span<T> {
+    return local_;
+  }
+
+  // Dynamic windows only
+  template <size_t Extent>
+  void attach(std::span<T, Extent> memory) const {
+    check_mpi_result(MPI_Win_attach(
+        native(), memory.data(), static_cast<MPI_Aint>(memory.size_bytes())));
+  }
+
+  template <size_t Extent>
+  void detach(std::span<T, Extent> memory) const {
+    check_mpi_result(MPI_Win_detach(native(), memory.data()));
+  }
+
+  // Target displacement of element in a dynamic window
+  [[nodiscard]]
+  static auto address(const T* element) -> MPI_Aint {
+    MPI_Aint addr = 0;
+    check_mpi_result(MPI_Get_address(element, &addr));
+    return addr;
+  }
+
+  template <size_t Extent>
+  void put(std::span<const T, Extent> origin,
+           int target,
+           MPI_Aint disp) const {
+    auto const count = static_cast<int>(origin.size());
+    check_mpi_result(MPI_Put(origin.data(), count, as_builtin_datatype<T>(),
+                             target, disp, count, as_builtin_datatype<T>(),
+                             native()));
+  }
+
+  template <size_t Extent>
+  void get(std::span<T, Extent> origin, int target, MPI_Aint disp) const {
+    auto const count = static_cast<int>(origin.size());
+    check_mpi_result(MPI_Get(origin.data(), count, as_builtin_datatype<T>(),
+                             target, disp, count, as_builtin_datatype<T>(),
+                             native()));
+  }
+
+  // Element-wise atomic target = operation(target, origin)
+  template <size_t Extent, accumulate_op Op>
+  void accumulate(std::span<const T, Extent> origin,
+                  int target,
+                  MPI_Aint disp,
+                  const Op& operation) const {
+    auto const count = static_cast<int>(origin.size());
+    check_mpi_result(MPI_Accumulate(
+        origin.data(), count, as_builtin_datatype<T>(), target, disp, count,
+        as_builtin_datatype<T>(), detail::native_op(operation), native()));
+  }
+
+  // Like accumulate, and stores the previous target values in result
+  template <size_t OriginExtent, size_t ResultExtent, accumulate_op Op>
+  void get_accumulate(std::span<const T, OriginExtent> origin,
+                      std::span<T, ResultExtent> result,
+                      int target,
+                      MPI_Aint disp,
+                      const Op& operation) const {
+    assert(origin.size() == result.size());
+    auto const count = static_cast<int>(result.size());
+    check_mpi_result(MPI_Get_accumulate(
+        origin.data(), count, as_builtin_datatype<T>(), result.data(), count,
+        as_builtin_datatype<T>(), target, disp, count,
+        as_builtin_datatype<T>(), detail::native_op(operation), native()));
+  }
+
+  // Single-element get_accumulate, e.g. an atomic fetch-and-add with
+  // std::plus<>{}; result is valid once the operation completes
+  template <accumulate_op Op>
+  void fetch_and_op(const T& value,
+                    T& result,
+                    int target,
+                    MPI_Aint disp,
+                    const Op& operation) const {
+    check_mpi_result(MPI_Fetch_and_op(&value, &result,
+                                      as_builtin_datatype<T>(), target, disp,
+                                      detail::native_op(operation),
+                                      native()));
+  }
+
+  // Atomically replaces the target element with desired if it equals
+  // expected; result receives the previous target value
+  void compare_and_swap(const T& desired,
+                        const T& expected,
+                        T& result,
+                        int target,
+                        MPI_Aint disp) const {
+    check_mpi_result(MPI_Compare_and_swap(&desired, &expected, &result,
+                                          as_builtin_datatype<T>(), target,
+                                          disp, native()));
+  }
+
+  // Active target: a fence epoch over all processes. Collective.
+  [[nodiscard]]
+  auto fence_epoch(int assertions = 0) const -> rma_epoch {
+    check_mpi_result(MPI_Win_fence(assertions, native()));
+    return {native(), rma_epoch::kind::fence};
+  }
+
+  // Active target, origin side: access to the windows of targets
+  [[nodiscard]]
+  auto access_epoch(std::span<const int> targets, int assertions = 0) const
+      -> rma_epoch {
+    group_guard group;
+    peer_group(targets, group);
+    check_mpi_result(MPI_Win_start(group.native(), assertions, native()));
+    return {native(), rma_epoch::kind::access};
+  }
+
+  // Active target, target side: exposes this window to origins
+  [[nodiscard]]
+  auto exposure_epoch(std::span<const int> origins, int assertions = 0) const
+      -> rma_epoch {
+    group_guard group;
+    peer_group(origins, group);
+    check_mpi_result(MPI_Win_post(group.native(), assertions, native()));
+    return {native(), rma_epoch::kind::exposure};
+  }
+
+  // Passive target: access to the window of rank without its involvement
+  [[nodiscard]]
+  auto lock(int rank,
+            lock_type type = lock_type::exclusive,
+            int assertions = 0) const -> rma_epoch {
+    check_mpi_result(
+        MPI_Win_lock(static_cast<int>(type), rank, assertions, native()));
+    return {native(), rma_epoch::kind::lock, rank};
+  }
+
+  // Passive target: shared access to the windows of all processes
+  [[nodiscard]]
+  auto lock_all(int assertions = 0) const -> rma_epoch {
+    check_mpi_result(MPI_Win_lock_all(assertions, native()));
+    return {native(), rma_epoch::kind::lock_all};
+  }
+
+  // Synchronizes the public and private copies of the local window
+  void sync() const { check_mpi_result(MPI_Win_sync(native())); }
+
+ private:
+  win_handle handle_;
+  std::span<T> local_;
+
+  // Owns an MPI_Group for the duration of an epoch call; MPI keeps its
+  // own reference for the epoch
+  class group_guard {
+   public:
+    group_guard() = default;
+    group_guard(const group_guard&) = delete;
+    auto operator=(const group_guard&) -> group_guard& = delete;
+    group_guard(group_guard&&) = delete;
+    auto operator=(group_guard&&) -> group_guard& = delete;
+
+    ~group_guard() {
+      if (group_ != MPI_GROUP_NULL) {
+        MPI_Group_free(&group_);
+      }
+    }
+
+    [[nodiscard]]
+    auto native() noexcept -> MPI_Group& {
+      return group_;
+    }
+
+   private:
+    MPI_Group group_{MPI_GROUP_NULL};
+  };
+
+  // Stores the group of the window's processes with the given ranks
+  void peer_group(std::span<const int> ranks, group_guard& peers) const {
+    group_guard all;
+    check_mpi_result(MPI_Win_get_group(native(), &all.native()));
+    check_mpi_result(MPI_Group_incl(all.native(),
+                                    static_cast<int>(ranks.size()),
+                                    ranks.data(), &peers.native()));
+  }
+};
+
+}  // namespace cxxmpi
@@ -1,10 +1,16 @@
+#include <algorithm>
+#include <array>
+#include <span>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 #include <catch2/catch_test_macros.hpp>
 #include <cxxmpi/cart_comm.hpp>
 #include <cxxmpi/comm.hpp>
+#include <cxxmpi/dims.hpp>
 #include <cxxmpi/error.hpp>
+#include <mpi.h>
 
 // NOLINTNEXTLINE
 TEST_CASE("Cartesian Communicator Basic Test", "[cart][mpi]") {
@@ -88,6 +94,158 @@ TEST_CASE("Cartesian Communicator Basic Test", "[cart][mpi]") {
         break;
     }
   }
+
+  SECTION("Shift exchange on a ring and an open chain") {
+    const auto size = comm_world().size();
+    const int rank = comm_world().rank();
+    const int n = static_cast<int>(size);
+
+    auto ring = cart_comm(comm_world(), {size}, {true}, false);
+    std::array<int, 2> out = {rank, rank * 10};
+    std::array<int, 2> in = {};
+    auto st = ring.exchange(0, 1, std::span<const int>{out}, std::span{in});
+    const int left = (rank + n - 1) % n;
+    CHECK(st.source() == left);
+    CHECK(in == std::array{left, left * 10});
+
+    auto chain = cart_comm(comm_world(), {size}, {false}, false);
+    in = {-1, -1};
+    chain.exchange(0, -1, std::span<const int>{out}, std::span{in});
+    if (rank == n - 1) {
+      CHECK(in == std::array{-1, -1});
+    } else {
+      CHECK(in == std::array{rank + 1, (rank + 1) * 10});
+    }
+  }
+
+  SECTION("Neighbor collectives on a ring") {
+    auto const size = comm_world().size();
+    auto ring = cart_comm(comm_world(), {size}, {true}, false);
+    auto const rank = ring.rank();
+    auto const n = static_cast<int>(size);
+    const int left = (rank + n - 1) % n;
+    const int right = (rank + 1) % n;
+    REQUIRE(ring.in_degree() == 2);
+    REQUIRE(ring.out_degree() == 2);
+
+    // Neighbors are ordered negative then positive direction
+    const std::array out = {rank};
+    std::array<int, 2> in = {};
+    ring.neighbor_allgather(std::span<const int>{out}, std::span{in});
+    CHECK(in == std::array{left, right});
+
+    const std::array blocks = {rank * 10, rank * 10 + 1};
+    in = {};
+    auto req = ring.ineighbor_alltoall(std::span<const int>{blocks},
+                                       std::span{in});
+    req.wait();
+    CHECK(in == std::array{left * 10 + 1, right * 10});
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("Cartesian topology is cached", "[cart][mpi]") {
+  using namespace cxxmpi;  // NOLINT
+  auto const size = static_cast<int>(comm_world().size());
+
+  // Mixed periodicity in three dimensions; the cached answers must match
+  // the ones MPI gives
+  auto cart = cart_comm(comm_world(), {static_cast<size_t>(size), 1, 1},
+                        {false, true, true}, true);
+  REQUIRE(cart.ndims() == 3);
+  const std::vector<int> dims = cart.dims();
+  CHECK(dims == std::vector{size, 1, 1});
+  CHECK(std::ranges::equal(cart.dims_view(), dims));
+  CHECK_FALSE(cart.periodic(0));
+  CHECK(cart.periodic(1));
+
+  std::array<int, 3> expected = {};
+  std::array<int, 3> actual = {};
+  for (int r = 0; r < size; ++r) {
+    MPI_Cart_coords(cart.native(), r, 3, expected.data());
+    cart.coords(r, actual);
+    CHECK(actual == expected);
+    CHECK(cart.rank(expected) == r);
+  }
+  CHECK(cart.coords() == cart.coords(cart.rank()));
+  CHECK(cart.coord(0) == cart.coords()[0]);
+
+  for (int direction = 0; direction < 3; ++direction) {
+    for (int disp = -2; disp <= 2; ++disp) {
+      int source = 0;
+      int dest = 0;
+      MPI_Cart_shift(cart.native(), direction, disp, &source, &dest);
+      CHECK(cart.shift(direction, disp) == std::pair{source, dest});
+    }
+  }
+
+  auto const table = cart.neighbors();
+  REQUIRE(table.size() == 6);
+  CHECK(std::pair{table[0], table[1]} == cart.shift(0, 1));
+  CHECK(table[2] == cart.rank());
+
+  // Diagonal neighbor wraps in the periodic dimensions only
+  const std::array down_left = {1, -1, 1};
+  auto const me = cart.coords();
+  auto const expected_neighbor =
+      me[0] + 1 < size ? cart.rank({me[0] + 1, 0, 0}) : MPI_PROC_NULL;
+  CHECK(cart.neighbor(down_left) == expected_neighbor);
+
+  auto const weak = weak_cart_comm{cart};
+  CHECK(weak.shift(0, 1) == cart.shift(0, 1));
+
+  CHECK_THROWS_AS(cart.rank({size, 0, 0}), mpi_error);
+  CHECK_THROWS_AS(cart.coords(size), mpi_error);
+  CHECK_THROWS_AS(cart.shift(3, 1), mpi_error);
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("Cartesian sub-communicators and reordering", "[cart][mpi]") {
+  using namespace cxxmpi;  // NOLINT
+  auto const grid = create_dims(static_cast<int>(comm_world().size()), 2);
+  auto const grid_dims = std::array{static_cast<size_t>(grid[0]),
+                                    static_cast<size_t>(grid[1])};
+  const std::array periods = {false, false};
+
+  SECTION("Rows and columns of a 2D grid") {
+    auto cart = cart_comm(comm_world(), grid_dims, periods, false);
+
+    auto row = cart.cart_sub({false, true});
+    REQUIRE(row.ndims() == 1);
+    CHECK(static_cast<int>(row.size()) == grid[1]);
+    CHECK(row.coord(0) == cart.coord(1));
+    auto const row_index = cart.coord(0);
+    CHECK(row.allreduce(row_index, std::ranges::max) == row_index);
+
+    auto column = cart.cart_sub({true, false});
+    CHECK(static_cast<int>(column.size()) == grid[0]);
+    CHECK(column.coord(0) == cart.coord(0));
+
+    CHECK_THROWS_AS(cart.cart_sub({true}), std::invalid_argument);
+  }
+
+  SECTION("Node-aware reordering keeps each node in one block") {
+    auto cart = cart_comm(comm_world(), grid_dims, periods, true);
+    REQUIRE(cart.size() == comm_world().size());
+
+    auto const node = cart.split_type(split_kind::shared);
+    auto const coords = cart.coords();
+    std::vector<int> all(2 * node.size());
+    node.allgather(std::span<const int>{coords}, std::span{all});
+
+    // The bounding box of the node's coordinates holds exactly its processes
+    int volume = 1;
+    for (size_t d = 0; d < 2; ++d) {
+      int low = grid[d];
+      int high = -1;
+      for (size_t i = d; i < all.size(); i += 2) {
+        low = std::min(low, all[i]);
+        high = std::max(high, all[i]);
+      }
+      volume *= high - low + 1;
+    }
+    CHECK(static_cast<size_t>(volume) == node.size());
+  }
 }
 
 TEST_CASE("Cartesian Communicator Error Handling", "[cart][mpi][error]") {
@@ -0,0 +1,291 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <numeric>
+#include <span>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <cxxmpi/comm.hpp>
+#include <cxxmpi/file.hpp>
+#include <cxxmpi/op.hpp>
+#include <mpi.h>
+
+TEST_CASE("Builtin reduction operators", "[mpi][op]") {
+  CHECK(cxxmpi::as_builtin_op<std::plus<>>() == MPI_SUM);
+  CHECK(cxxmpi::as_builtin_op<std::plus<int>>() == MPI_SUM);
+  CHECK(cxxmpi::as_builtin_op<std::multiplies<>>() == MPI_PROD);
+  CHECK(cxxmpi::as_builtin_op<std::bit_xor<unsigned>>() == MPI_BXOR);
+  CHECK(cxxmpi::as_builtin_op<decltype(std::ranges::max)>() == MPI_MAX);
+  CHECK(cxxmpi::as_builtin_op<decltype(std::ranges::min)>() == MPI_MIN);
+
+  STATIC_REQUIRE(cxxmpi::builtin_op<std::logical_or<>>);
+  STATIC_REQUIRE_FALSE(cxxmpi::builtin_op<std::minus<>>);
+  STATIC_REQUIRE(cxxmpi::reduction_op<MPI_Op>);
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("Allreduce and reduce", "[mpi][collective]") {
+  const auto& comm = cxxmpi::comm_world();
+  const int rank = comm.rank();
+  const int size = static_cast<int>(comm.size());
+
+  SECTION("Span allreduce with builtin op") {
+    const std::array<double, 3> send_data = {1.0, 2.0, rank + 1.0};
+    std::array<double, 3> recv_data = {};
+    comm.allreduce(std::span<const double>{send_data}, std::span{recv_data},
+                   std::plus<>{});
+    CHECK(recv_data == std::array{size * 1.0, size * 2.0,
+                                  size * (size + 1) / 2.0});
+  }
+
+  SECTION("In-place allreduce") {
+    std::vector<int> data = {rank, -rank};
+    comm.allreduce(std::span{data}, std::ranges::max);
+    CHECK(data == std::vector{size - 1, 0});
+  }
+
+  SECTION("Single value allreduce") {
+    CHECK(comm.allreduce(rank, std::ranges::min) == 0);
+    CHECK(comm.allreduce(rank + 1, MPI_SUM) == size * (size + 1) / 2);
+  }
+
+  SECTION("Reduce to root") {
+    const std::array<int, 2> send_data = {1, rank};
+    std::array<int, 2> recv_data = {};
+    comm.reduce(std::span<const int>{send_data}, std::span{recv_data},
+                std::plus<>{}, 0);
+    if (rank == 0) {
+      CHECK(recv_data == std::array{size, size * (size - 1) / 2});
+    }
+  }
+
+  SECTION("In-place reduce to non-zero root") {
+    const int root = size - 1;
+    std::array<int, 1> data = {rank + 1};
+    comm.reduce(std::span{data}, std::multiplies<>{}, root);
+    if (rank == root) {
+      int expected = 1;
+      for (int i = 1; i <= size; ++i) {
+        expected *= i;
+      }
+      CHECK(data[0] == expected);
+    } else {
+      CHECK(data[0] == rank + 1);
+    }
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("Broadcast, gather and scatter", "[mpi][collective]") {
+  const auto& comm = cxxmpi::comm_world();
+  const int rank = comm.rank();
+  const int size = static_cast<int>(comm.size());
+  const int root = size - 1;
+
+  SECTION("Broadcast span and single value") {
+    std::array<double, 2> data = {};
+    int value = 0;
+    if (rank == root) {
+      data = {1.5, 2.5};
+      value = 7;
+    }
+    comm.bcast(std::span{data}, root);
+    comm.bcast(value, root);
+    CHECK(data == std::array{1.5, 2.5});
+    CHECK(value == 7);
+  }
+
+  SECTION("Gather and allgather") {
+    const auto gathered = comm.gather(rank * 2, root);
+    const auto all = comm.allgather(rank * 2);
+    REQUIRE(all.size() == comm.size());
+    for (int i = 0; i < size; ++i) {
+      CHECK(all[static_cast<size_t>(i)] == i * 2);
+    }
+    if (rank == root) {
+      CHECK(gathered == all);
+    } else {
+      CHECK(gathered.empty());
+    }
+  }
+
+  SECTION("Scatter") {
+    std::vector<int> send_data;
+    if (rank == 0) {
+      for (int i = 0; i < size * 2; ++i) {
+        send_data.push_back(i);
+      }
+    }
+    std::array<int, 2> recv_data = {};
+    comm.scatter(std::span<const int>{send_data}, std::span{recv_data});
+    CHECK(recv_data == std::array{rank * 2, rank * 2 + 1});
+  }
+
+  SECTION("Gatherv and scatterv with computed displacements") {
+    // rank r contributes r + 1 copies of r
+    std::vector<int> counts(comm.size());
+    std::iota(counts.begin(), counts.end(), 1);
+    const std::vector<int> mine(static_cast<size_t>(rank + 1), rank);
+
+    std::vector<int> all(static_cast<size_t>(size * (size + 1) / 2), -1);
+    comm.gatherv(std::span<const int>{mine}, std::span{all},
+                 std::span<const int>{counts}, root);
+    if (rank == root) {
+      auto it = all.begin();
+      for (int i = 0; i < size; ++i) {
+        for (int j = 0; j <= i; ++j) {
+          CHECK(*it++ == i);
+        }
+      }
+    }
+
+    std::vector<int> back(static_cast<size_t>(rank + 1), -1);
+    comm.scatterv(std::span<const int>{all}, std::span<const int>{counts},
+                  std::span{back}, root);
+    CHECK(back == mine);
+  }
+
+  SECTION("Allgatherv exchanging counts") {
+    const std::vector<double> mine(static_cast<size_t>(rank),
+                                   static_cast<double>(rank));
+    const auto result = comm.allgatherv(std::span<const double>{mine});
+    REQUIRE(result.counts.size() == comm.size());
+    REQUIRE(result.values.size() == static_cast<size_t>(size * (size - 1) / 2));
+    for (int i = 0; i < size; ++i) {
+      const auto part = result[static_cast<size_t>(i)];
+      CHECK(part.size() == static_cast<size_t>(i));
+      CHECK(std::ranges::all_of(part, [i](double v) {
+        return static_cast<int>(v) == i;
+      }));
+    }
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("Scan and reduce_scatter", "[mpi][collective]") {
+  const auto& comm = cxxmpi::comm_world();
+  const int rank = comm.rank();
+  const int size = static_cast<int>(comm.size());
+
+  SECTION("Inclusive and exclusive scan") {
+    CHECK(comm.scan(rank + 1, std::plus<>{}) == (rank + 1) * (rank + 2) / 2);
+    CHECK(comm.exscan(rank + 1, std::plus<>{}) == rank * (rank + 1) / 2);
+
+    std::array<long long, 2> data = {1, rank};
+    comm.scan(std::span{data}, std::ranges::max);
+    CHECK(data == std::array<long long, 2>{1, rank});
+  }
+
+  SECTION("Exclusive scan offset for collective file writes") {
+    const MPI_Offset local_bytes = 16 * (rank + 1);
+    CHECK(cxxmpi::exscan_offset(comm, local_bytes) == 8 * rank * (rank + 1));
+  }
+
+  SECTION("Reduce_scatter_block") {
+    std::vector<int> send_data(comm.size() * 2);
+    std::iota(send_data.begin(), send_data.end(), 0);
+    std::array<int, 2> recv_data = {};
+    comm.reduce_scatter_block(std::span<const int>{send_data},
+                              std::span{recv_data}, std::plus<>{});
+    CHECK(recv_data == std::array{rank * 2 * size, (rank * 2 + 1) * size});
+  }
+
+  SECTION("Reduce_scatter with varying counts") {
+    std::vector<int> counts(comm.size());
+    std::iota(counts.begin(), counts.end(), 1);
+    std::vector<int> send_data(static_cast<size_t>(size * (size + 1) / 2), 1);
+    std::vector<int> recv_data(static_cast<size_t>(rank + 1));
+    comm.reduce_scatter(std::span<const int>{send_data}, std::span{recv_data},
+                        std::span<const int>{counts}, std::plus<>{});
+    CHECK(std::ranges::all_of(recv_data, [size](int v) { return v == size; }));
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("Nonblocking collectives", "[mpi][collective][nonblocking]") {
+  const auto& comm = cxxmpi::comm_world();
+  const int rank = comm.rank();
+  const int size = static_cast<int>(comm.size());
+
+  SECTION("Barrier and in-place allreduce") {
+    auto barrier = comm.ibarrier();
+    std::array<int, 2> data = {rank, 1};
+    auto req = comm.iallreduce(std::span{data}, std::plus<>{});
+    CHECK(req.active());
+    req.wait_without_status();
+    CHECK_FALSE(req.active());
+    CHECK(data == std::array{size * (size - 1) / 2, size});
+    barrier.wait();
+  }
+
+  SECTION("Counts may go out of scope before completion") {
+    const std::vector<int> mine(static_cast<size_t>(rank + 1), rank);
+    std::vector<int> all(static_cast<size_t>(size * (size + 1) / 2), -1);
+    cxxmpi::request req;
+    {
+      std::vector<int> counts(comm.size());
+      std::iota(counts.begin(), counts.end(), 1);
+      req = comm.iallgatherv(std::span<const int>{mine}, std::span{all},
+                             std::span<const int>{counts});
+    }
+    while (!req.test()) {
+    }
+    auto it = all.begin();
+    for (int i = 0; i < size; ++i) {
+      for (int j = 0; j <= i; ++j) {
+        CHECK(*it++ == i);
+      }
+    }
+  }
+
+  SECTION("Destructor completes the operation") {
+    int value = rank == 0 ? 42 : 0;
+    {
+      auto req = comm.ibcast(std::span<int, 1>{&value, 1});
+    }
+    CHECK(value == 42);
+  }
+
+  SECTION("Alltoallv with per-call arrays") {
+    std::vector<int> counts(comm.size(), 1);
+    std::vector<int> displs(comm.size());
+    std::iota(displs.begin(), displs.end(), 0);
+    std::vector<int> send_data(comm.size(), rank);
+    std::vector<int> recv_data(comm.size(), -1);
+    auto req = comm.ialltoallv(
+        std::span<const int>{send_data}, std::span<const int>{counts},
+        std::span<const int>{displs}, std::span{recv_data},
+        std::span<const int>{counts}, std::span<const int>{displs});
+    req.wait();
+    CHECK(recv_data[static_cast<size_t>(size - 1)] == size - 1);
+    CHECK(recv_data[0] == 0);
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("Nonblocking file I/O", "[mpi][file][nonblocking]") {
+  const auto& comm = cxxmpi::comm_world();
+  const int rank = comm.rank();
+  const int size = static_cast<int>(comm.size());
+  const int right = (rank + 1) % size;
+
+  auto fh = cxxmpi::open("cxxmpi_nonblocking_io_test.bin", comm,
+                         MPI_MODE_CREATE | MPI_MODE_RDWR
+                             | MPI_MODE_DELETE_ON_CLOSE);
+  const std::array<int, 4> out = {rank, rank + 1, rank + 2, rank + 3};
+  const MPI_Offset offset = rank * static_cast<MPI_Offset>(sizeof(out));
+  auto write = fh.iwrite_at(offset, std::span{out});
+  write.wait_without_status();
+  fh.sync();
+  comm.barrier();
+
+  std::array<int, 4> in = {};
+  const MPI_Offset neighbor = right * static_cast<MPI_Offset>(sizeof(in));
+  auto read = fh.iread_at(neighbor, std::span{in});
+  auto st = read.wait();
+  CHECK(st.count<int>() == 4);
+  CHECK(in == std::array{right, right + 1, right + 2, right + 3});
+  comm.barrier();
+}
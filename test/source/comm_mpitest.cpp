@@ -1,6 +1,10 @@
+#include <algorithm>
 #include <array>
 #include <cstddef>
+#include <functional>
+#include <optional>
 #include <span>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -265,6 +269,305 @@ TEST_CASE("Non-blocking Communication Tests", "[mpi]") {
       REQUIRE(recv_data == std::array{1, 2, 3});
     }
   }
+
+  SECTION("Draining a request_group with wait_some and test_some") {
+    constexpr int per_peer = 8;
+    const auto num_msgs = static_cast<size_t>((size - 1) * per_peer);
+    if (rank == 0) {
+      std::vector<int> recv_data(num_msgs, -1);
+      cxxmpi::request_group requests{num_msgs};
+      for (size_t i = 0; i < num_msgs; ++i) {
+        const int src = static_cast<int>(i) / per_peer + 1;
+        const int tag = static_cast<int>(i) % per_peer;
+        comm.irecv(std::span{recv_data}.subspan(i, 1), src, tag,
+                   requests.add());
+      }
+      REQUIRE(requests.active() == num_msgs);
+
+      std::vector<int> seen(num_msgs, 0);
+      while (requests.active() > 0) {
+        for (auto [index, st] : requests.wait_some()) {
+          CHECK(st.source() == static_cast<int>(index) / per_peer + 1);
+          ++seen[index];
+        }
+      }
+      CHECK(requests.empty());
+      CHECK(std::ranges::all_of(seen, [](int n) { return n == 1; }));
+      for (size_t i = 0; i < num_msgs; ++i) {
+        CHECK(recv_data[i] == static_cast<int>(i));
+      }
+    } else {
+      std::vector<int> send_data(per_peer);
+      cxxmpi::request_group requests;
+      for (int tag = 0; tag < per_peer; ++tag) {
+        send_data[static_cast<size_t>(tag)] = (rank - 1) * per_peer + tag;
+        comm.isend(std::span<const int>{send_data}.subspan(
+                       static_cast<size_t>(tag), 1),
+                   0, tag, requests.add());
+      }
+
+      std::array<int, per_peer> indices = {};
+      std::array<cxxmpi::status, per_peer> statuses = {};
+      size_t retired = 0;
+      while (requests.active() > 0) {
+        retired += requests.test_some(indices, statuses);
+      }
+      CHECK(retired == static_cast<size_t>(per_peer));
+    }
+  }
+
+  SECTION("wait_any keeps completed slots, wait_some recycles them") {
+    std::array<int, 2> out = {rank, rank + 1};
+    std::array<int, 2> in = {};
+    cxxmpi::request_group group;
+    for (size_t i = 0; i < 2; ++i) {
+      comm.irecv(std::span{in}.subspan(i, 1), rank, 4, group.add());
+    }
+    comm.send(std::span<const int>{out}.first(1), rank, 4);
+    comm.send(std::span<const int>{out}.subspan(1, 1), rank, 4);
+
+    auto [first, first_st] = group.wait_any();
+    cxxmpi::status st{};
+    std::optional<size_t> second;
+    while (!second) {
+      second = group.test_any(st);
+    }
+    CHECK(first != *second);
+    CHECK(first_st.source() == rank);
+    CHECK(group.active() == 0);
+    CHECK(group.size() == 2);
+    CHECK(group[first] == MPI_REQUEST_NULL);
+    CHECK(group[*second] == MPI_REQUEST_NULL);
+    CHECK(in == out);
+
+    CHECK(group.wait_some().empty());
+    CHECK(group.empty());
+  }
+
+  SECTION("Completion handlers re-post receives") {
+    constexpr int num_msgs = 16;
+    const int right = (rank + 1) % size;
+    const int left = (rank + size - 1) % size;
+
+    std::array<int, num_msgs> out = {};
+    cxxmpi::request_group sends;
+    for (int i = 0; i < num_msgs; ++i) {
+      out[static_cast<size_t>(i)] = rank * num_msgs + i;
+      comm.isend(std::span<const int>{out}.subspan(static_cast<size_t>(i), 1),
+                 right, 3, sends.add());
+    }
+
+    cxxmpi::request_group recvs;
+    std::array<int, 1> slot = {};
+    std::vector<int> unpacked;
+    std::function<void(const cxxmpi::status&)> on_recv;
+    auto post = [&] {
+      comm.irecv(std::span{slot}, left, 3, recvs.add(on_recv));
+    };
+    on_recv = [&](const cxxmpi::status& st) {
+      CHECK(st.source() == left);
+      unpacked.push_back(slot[0]);
+      if (unpacked.size() < num_msgs) {
+        post();
+      }
+    };
+    post();
+    while (recvs.active() > 0) {
+      (void)recvs.wait_some();
+    }
+    sends.wait_all_without_status();
+
+    REQUIRE(unpacked.size() == num_msgs);
+    for (int i = 0; i < num_msgs; ++i) {
+      CHECK(unpacked[static_cast<size_t>(i)] == left * num_msgs + i);
+    }
+  }
+
+  SECTION("Inline and heap-stored handlers run from wait_all") {
+    std::array<int, 1> value = {rank};
+    std::array<int, 1> result = {};
+    int small_calls = 0;
+    std::array<long long, 8> large_capture = {1, 2, 3, 4, 5, 6, 7, 8};
+    long long large_sum = 0;
+    static_assert(sizeof(large_capture)
+                  > cxxmpi::completion_handler::inline_size);
+
+    cxxmpi::request_group group;
+    MPI_Request& first = group.add([&small_calls](const cxxmpi::status&) {
+      ++small_calls;
+    });
+    comm.isend(std::span<const int>{value}, rank, 9, first);
+    MPI_Request& second =
+        group.add([large_capture, &large_sum](const cxxmpi::status& st) {
+          CHECK(st.tag() == 9);
+          for (auto v : large_capture) {
+            large_sum += v;
+          }
+        });
+    comm.irecv(std::span{result}, rank, 9, second);
+    group.wait_all_without_status();
+
+    CHECK(group.empty());
+    CHECK(small_calls == 1);
+    CHECK(large_sum == 36);
+    CHECK(result[0] == rank);
+  }
+
+  SECTION("Owning request and futures") {
+    if (rank == 0) {
+      const std::array<int, 2> header = {7, 3};
+      auto req = comm.isend(std::span<const int>{header}, 1, 1);
+      auto payload = comm.isend(std::vector<int>{1, 2, 3}, 1, 2);
+      req.wait();
+      CHECK_FALSE(req.active());
+      auto buffer = payload.get();
+      CHECK(buffer == std::vector<int>{1, 2, 3});
+    } else if (rank == 1) {
+      std::array<int, 2> header = {};
+      auto req = comm.irecv(std::span{header}, 0, 1);
+      auto st = req.wait();
+      CHECK(st.source() == 0);
+      CHECK(header == std::array{7, 3});
+
+      auto payload = comm.irecv(std::vector<int>(3), 0, 2);
+      auto moved = std::move(payload);
+      CHECK(moved.get() == std::vector<int>{1, 2, 3});
+    }
+  }
+
+  SECTION("Cancelled receive") {
+    std::array<int, 1> never_sent = {};
+    auto req = comm.irecv(std::span{never_sent}, rank, 99);
+    auto st = req.cancel();
+    CHECK(st.cancelled());
+    CHECK_FALSE(req.active());
+
+    auto speculative = comm.irecv(std::vector<int>(1), rank, 99);
+    speculative.cancel_on_destroy();
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("Combined send and receive", "[mpi][sendrecv]") {
+  const auto& comm = cxxmpi::comm_world();
+  const int rank = comm.rank();
+  const int size = static_cast<int>(comm.size());
+  const int right = (rank + 1) % size;
+  const int left = (rank + size - 1) % size;
+
+  SECTION("Span and single value") {
+    const std::array<int, 3> out = {rank, rank + 1, rank + 2};
+    std::array<int, 3> in = {};
+    auto st = comm.sendrecv(std::span<const int>{out}, right, std::span{in},
+                            left, 5);
+    CHECK(st.source() == left);
+    CHECK(in == std::array{left, left + 1, left + 2});
+
+    int received = -1;
+    comm.sendrecv(rank, right, received, left);
+    CHECK(received == left);
+  }
+
+  SECTION("Custom datatypes with separate tags") {
+    auto pair_type = cxxmpi::dtype{cxxmpi::as_weak_dtype<int>(), 2};
+    pair_type.commit();
+    const std::array<int, 4> out = {rank, rank, rank, rank};
+    std::array<int, 4> in = {};
+    comm.sendrecv(std::span<const int>{out}, cxxmpi::weak_dtype{pair_type}, 2,
+                  right, 1,
+                  std::span{in}, cxxmpi::as_weak_dtype<int>(), 4, left, 1);
+    CHECK(in == std::array{left, left, left, left});
+  }
+
+  SECTION("In-place replace") {
+    std::array<int, 2> data = {rank, -rank};
+    comm.sendrecv_replace(std::span{data}, right, left, 6);
+    CHECK(data == std::array{left, -left});
+
+    int value = rank;
+    comm.sendrecv_replace(value, left, right);
+    CHECK(value == right);
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("Probe and matched receive", "[mpi][probe]") {
+  const auto& comm = cxxmpi::comm_world();
+  const int rank = comm.rank();
+  const int size = static_cast<int>(comm.size());
+  const int right = (rank + 1) % size;
+  const int left = (rank + size - 1) % size;
+
+  SECTION("Receive into a vector sized by the message") {
+    std::vector<int> out(static_cast<size_t>(rank + 1), rank);
+    auto req = comm.isend(std::span<const int>{out}, right, 1);
+    std::vector<int> in;
+    auto st = comm.recv(in, left, 1);
+    req.wait_without_status();
+    CHECK(st.source() == left);
+    CHECK(in == std::vector<int>(static_cast<size_t>(left + 1), left));
+  }
+
+  SECTION("Receive into a string") {
+    const std::string out = "rank " + std::to_string(rank);
+    auto req = comm.isend(std::span<const char>{out}, right, 2);
+    std::string in;
+    comm.recv(in, left, 2);
+    req.wait_without_status();
+    CHECK(in == "rank " + std::to_string(left));
+  }
+
+  SECTION("Probe, iprobe and improbe") {
+    const std::array<double, 3> out = {1.0, 2.0, 3.0};
+    auto req = comm.isend(std::span<const double>{out}, right, 3);
+
+    auto st = comm.probe(left, 3);
+    CHECK(st.count<double>() == 3);
+    auto peeked = comm.iprobe(left, 3);
+    REQUIRE(peeked.has_value());
+    CHECK(peeked->source() == left);
+
+    auto matched = comm.improbe(left, 3);
+    while (!matched) {
+      matched = comm.improbe(left, 3);
+    }
+    auto& [msg, matched_st] = *matched;
+    CHECK(static_cast<bool>(msg));
+    CHECK_FALSE(comm.iprobe(left, 3).has_value());
+    std::array<double, 3> in = {};
+    auto recv = msg.irecv(std::span{in});
+    recv.wait();
+    req.wait_without_status();
+    CHECK(matched_st.count<double>() == 3);
+    CHECK(in == out);
+  }
+
+  SECTION("Matched messages with a derived datatype") {
+    auto pair_type = cxxmpi::dtype{
+        cxxmpi::weak_dtype{cxxmpi::weak_dtype_handle{MPI_INT}}, 2};
+    pair_type.commit();
+    const std::array out = {rank, rank + 1, rank + 2, rank + 3};
+    auto req = comm.isend(std::span<const int>{out}, right, 4);
+
+    // A received message can take over another matched one
+    cxxmpi::message msg;
+    auto [first, first_st] = comm.mprobe(left, 4);
+    msg = std::move(first);
+    std::array<int, 4> in = {};
+    msg.irecv(std::span{in}, cxxmpi::weak_dtype{pair_type}, 2)
+        .wait_without_status();
+    CHECK(in == std::array{left, left + 1, left + 2, left + 3});
+    CHECK_FALSE(static_cast<bool>(msg));
+
+    auto req2 = comm.isend(std::span<const int>{out}, right, 5);
+    auto [second, second_st] = comm.mprobe(left, 5);
+    msg = std::move(second);
+    CHECK(static_cast<bool>(msg));
+    msg.recv(std::span{in});
+    req.wait_without_status();
+    req2.wait_without_status();
+    CHECK(first_st.count<int>() == 4);
+  }
 }
 
 // NOLINTNEXTLINE
@@ -282,3 +585,19 @@ TEST_CASE("Error Handling Tests", "[mpi]") {
     }
   }
 }
+
+// NOLINTNEXTLINE
+TEST_CASE("Split by type", "[mpi][split]") {
+  const auto& world = cxxmpi::comm_world();
+  auto node = world.split_type(cxxmpi::split_kind::shared);
+  REQUIRE(node.size() >= 1);
+  REQUIRE(node.size() <= world.size());
+
+  // The lowest world rank on the node is node rank 0
+  auto const first = node.allreduce(world.rank(), std::ranges::min);
+  CHECK((node.rank() == 0) == (first == world.rank()));
+
+  // A descending key reverses the order
+  auto reversed = world.split_type(cxxmpi::split_kind::shared, -world.rank());
+  CHECK(reversed.rank() == static_cast<int>(node.size()) - 1 - node.rank());
+}
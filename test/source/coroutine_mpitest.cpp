@@ -0,0 +1,116 @@
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <cxxmpi/comm.hpp>
+#include <cxxmpi/coroutine.hpp>
+#include <mpi.h>
+
+namespace {
+
+auto exchange_with_neighbors(cxxmpi::scheduler& sched,
+                             const cxxmpi::weak_comm& communicator,
+                             int flow) -> cxxmpi::task<int> {
+  const int rank = communicator.rank();
+  const int size = static_cast<int>(communicator.size());
+  const int right = (rank + 1) % size;
+  const int left = (rank + size - 1) % size;
+
+  std::array<int, 1> out = {rank * 1000 + flow};
+  std::array<int, 1> in = {};
+  auto recv = sched.wait(communicator.irecv(std::span{in}, left, flow));
+  auto send = sched.wait(
+      communicator.isend(std::span<const int>{out}, right, flow));
+  auto st = co_await std::move(recv);
+  co_await std::move(send);
+  CHECK(st.source() == left);
+  co_return in[0];
+}
+
+auto ring_flow(cxxmpi::scheduler& sched,
+               const cxxmpi::weak_comm& communicator,
+               int flow,
+               std::vector<int>& results) -> cxxmpi::task<> {
+  results[static_cast<std::size_t>(flow)] =
+      co_await exchange_with_neighbors(sched, communicator, flow);
+}
+
+auto allreduce_flow(cxxmpi::scheduler& sched,
+                    const cxxmpi::weak_comm& communicator,
+                    int& result) -> cxxmpi::task<> {
+  std::array<int, 1> value = {communicator.rank() + 1};
+  co_await sched.schedule();
+  co_await sched.wait(
+      communicator.iallreduce(std::span{value}, std::plus<int>{}));
+  result = value[0];
+}
+
+auto owned_buffer_flow(cxxmpi::scheduler& sched,
+                       const cxxmpi::weak_comm& communicator,
+                       std::vector<int>& result) -> cxxmpi::task<> {
+  const int rank = communicator.rank();
+  const int size = static_cast<int>(communicator.size());
+  auto pending =
+      sched.wait(communicator.irecv(std::vector<int>(2), (rank + 1) % size, 7));
+  std::vector<int> payload(2, rank);
+  auto sent = co_await sched.wait(
+      communicator.isend(std::move(payload), (rank + size - 1) % size, 7));
+  CHECK(sent == std::vector<int>(2, rank));
+  result = co_await std::move(pending);
+}
+
+auto failing_flow() -> cxxmpi::task<> {
+  throw std::runtime_error("flow failed");
+  co_return;
+}
+
+}  // namespace
+
+// NOLINTNEXTLINE
+TEST_CASE("Coroutine scheduler", "[mpi][coroutine]") {
+  const cxxmpi::weak_comm communicator{cxxmpi::comm_world()};
+  const int rank = communicator.rank();
+  const int size = static_cast<int>(communicator.size());
+  const int left = (rank + size - 1) % size;
+
+  SECTION("Many concurrent point-to-point flows") {
+    constexpr int num_flows = 200;
+    std::vector<int> results(num_flows, -1);
+    cxxmpi::scheduler sched;
+    for (int flow = 0; flow < num_flows; ++flow) {
+      sched.spawn(ring_flow(sched, communicator, flow, results));
+    }
+    CHECK(sched.active() == num_flows);
+    sched.run();
+    CHECK(sched.active() == 0);
+    CHECK(sched.pending() == 0);
+    for (int flow = 0; flow < num_flows; ++flow) {
+      CHECK(results[static_cast<std::size_t>(flow)] == left * 1000 + flow);
+    }
+  }
+
+  SECTION("Nonblocking collective and owned buffers") {
+    int sum = 0;
+    std::vector<int> received;
+    cxxmpi::scheduler sched;
+    sched.spawn(allreduce_flow(sched, communicator, sum));
+    sched.spawn(owned_buffer_flow(sched, communicator, received));
+    while (sched.poll()) {
+    }
+    CHECK(sum == size * (size + 1) / 2);
+    const int right = (rank + 1) % size;
+    CHECK(received == std::vector<int>{right, right});
+  }
+
+  SECTION("Exceptions escape run") {
+    cxxmpi::scheduler sched;
+    sched.spawn(failing_flow());
+    CHECK_THROWS_AS(sched.run(), std::runtime_error);
+    CHECK(sched.active() == 0);
+  }
+}
@@ -1,10 +1,12 @@
 #include <mpi.h>
 
 #define CATCH_CONFIG_RUNNER
+#include <algorithm>
 #include <exception>
 #include <iostream>
 
 #include <catch2/catch_session.hpp>
+#include <cxxmpi/comm.hpp>
 #include <cxxmpi/universe.hpp>
 
 auto main(int argc, char* argv[]) -> int {
@@ -16,10 +18,7 @@ auto main(int argc, char* argv[]) -> int {
     const int result = Catch::Session().run(argc, argv);
 
     // Ensure all processes return the same result
-    int global_result = 0;
-    MPI_Allreduce(&result, &global_result, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
-
-    return global_result;
+    return cxxmpi::comm_world().allreduce(result, std::ranges::max);
   } catch (const std::exception& e) {
     std::cerr << "Error: " << e.what() << '\n';
     return 1;
@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
 #include <span>
 #include <stdexcept>
 #include <vector>
@@ -5,6 +8,8 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers.hpp>
 #include <catch2/matchers/catch_matchers_vector.hpp>
+#include <cxxmpi/cart_comm.hpp>
+#include <cxxmpi/comm.hpp>
 #include <cxxmpi/dims.hpp>
 #include <mpi.h>
 
@@ -74,3 +79,149 @@ TEST_CASE("create_dims basic functionality", "[mpi][dims]") {
     }
   }
 }
+
+// NOLINTNEXTLINE
+TEST_CASE("Node blocks of a process grid", "[mpi][dims]") {
+  SECTION("block with the smallest surface towards other nodes") {
+    const std::vector square{4, 4};
+    CHECK(cxxmpi::detail::node_block_shape(square, 4) == std::vector{2, 2});
+
+    // A node holding a whole dimension does not communicate across it
+    const std::vector slab{8, 2};
+    CHECK(cxxmpi::detail::node_block_shape(slab, 4) == std::vector{2, 2});
+
+    const std::vector line{6, 1};
+    CHECK(cxxmpi::detail::node_block_shape(line, 3) == std::vector{3, 1});
+  }
+
+  SECTION("no block when the node size does not tile the grid") {
+    const std::vector odd{3, 5};
+    CHECK(cxxmpi::detail::node_block_shape(odd, 2).empty());
+  }
+
+  SECTION("nodes tile the grid in row-major order") {
+    const std::vector dims{4, 4};
+    const std::vector block{2, 2};
+    // Node 1 owns rows 0-1 and columns 2-3
+    CHECK(cxxmpi::detail::node_block_rank(dims, block, 1, 0) == 2);
+    CHECK(cxxmpi::detail::node_block_rank(dims, block, 1, 3) == 7);
+    CHECK(cxxmpi::detail::node_block_rank(dims, block, 2, 1) == 9);
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("Node-aware create_dims", "[mpi][dims]") {
+  const auto& world = cxxmpi::comm_world();
+  auto const nprocs = static_cast<int>(world.size());
+
+  SECTION("halo bytes crossing nodes") {
+    const std::vector domain{96, 96};
+    const std::vector dims{4, 4};
+    // 2x2 processes per node own 48x48 cells and cut both dimensions
+    const std::vector block{2, 2};
+    CHECK(cxxmpi::inter_node_halo_bytes(domain, dims, block, 1, 8) ==
+          4 * 48 * 8);
+    CHECK(cxxmpi::inter_node_halo_bytes(domain, dims, block, 2, 8) ==
+          2 * 4 * 48 * 8);
+
+    // A node spanning a whole dimension keeps that halo inside
+    const std::vector rows{1, 4};
+    CHECK(cxxmpi::inter_node_halo_bytes(domain, dims, rows, 1, 1) == 2 * 96);
+    CHECK(cxxmpi::inter_node_halo_bytes(domain, dims, dims, 1, 1) == 0);
+  }
+
+  SECTION("processes per node is uniform on a single node") {
+    auto const ppn = cxxmpi::processes_per_node(world);
+    CHECK(ppn > 0);
+    CHECK(nprocs % ppn == 0);
+  }
+
+  SECTION("grid follows the domain shape") {
+    // Cutting the long dimension keeps the faces small
+    auto dims = cxxmpi::create_dims(world, {100, 100 * nprocs});
+    CHECK(dims == std::vector{1, nprocs});
+
+    dims = cxxmpi::create_dims(world, {100 * nprocs, 100});
+    CHECK(dims == std::vector{nprocs, 1});
+  }
+
+  SECTION("square domain gives a compact grid") {
+    auto const dims = cxxmpi::create_dims(world, {120, 120});
+    CHECK(dims == cxxmpi::create_dims(nprocs, 2));
+  }
+
+  SECTION("empty domain throws") {
+    const std::vector<int> empty;
+    REQUIRE_THROWS_AS(cxxmpi::create_dims(world, std::span{empty}),
+                      std::invalid_argument);
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("Reordering applies the node block create_dims costed",
+          "[mpi][dims][cart]") {
+  SECTION("node block for the domain rather than for the grid") {
+    struct layout {
+      int nprocs;
+      int ppn;
+      std::vector<int> domain;
+      std::vector<int> block;
+      std::size_t cost;
+    };
+    const std::vector<layout> layouts = {
+        {32, 2, {1000, 1000}, {2, 1}, 1000},
+        {32, 4, {4000, 1000}, {1, 4}, 2000},
+        {48, 4, {4000, 1000}, {1, 4}, 2000},
+    };
+    for (auto const& l : layouts) {
+      auto const grid = cxxmpi::detail::choose_grid(l.domain, l.nprocs, l.ppn);
+      CHECK(grid.block == l.block);
+      CHECK(grid.node_cost == l.cost);
+      auto const bytes =
+          cxxmpi::inter_node_halo_bytes(l.domain, grid.dims, grid.block, 1, 1);
+      CHECK(bytes == grid.node_cost);
+      // What the domain-aware cart_comm reorders with
+      CHECK(cxxmpi::detail::best_node_block(l.domain, grid.dims, l.ppn).block
+            == grid.block);
+      // The grid alone would pick a block with more inter-node traffic
+      CHECK(cxxmpi::detail::node_block_shape(grid.dims, l.ppn) != grid.block);
+    }
+  }
+
+  SECTION("each node owns the block create_dims costed") {
+    const auto& world = cxxmpi::comm_world();
+    auto const nprocs = static_cast<int>(world.size());
+    const std::vector domain{400 * nprocs, 100};
+    auto const grid = cxxmpi::create_dims(world, domain);
+    auto const ppn = cxxmpi::processes_per_node(world);
+    auto const expected =
+        cxxmpi::detail::choose_grid(domain, nprocs, ppn).block;
+    REQUIRE(expected.size() == 2);
+
+    const std::array grid_dims = {static_cast<size_t>(grid[0]),
+                                  static_cast<size_t>(grid[1])};
+    const std::array periods = {false, false};
+    auto cart = cxxmpi::cart_comm(world, grid_dims, periods,
+                                  std::span<const int>{domain});
+    REQUIRE(cart.size() == world.size());
+
+    auto const node = cart.split_type(cxxmpi::split_kind::shared);
+    auto const coords = cart.coords();
+    std::vector<int> all(2 * node.size());
+    node.allgather(std::span<const int>{coords}, std::span{all});
+    for (std::size_t d = 0; d < 2; ++d) {
+      int low = grid[d];
+      int high = -1;
+      for (auto i = d; i < all.size(); i += 2) {
+        low = std::min(low, all[i]);
+        high = std::max(high, all[i]);
+      }
+      CHECK(high - low + 1 == expected[d]);
+    }
+
+    const std::array line = {100};
+    CHECK_THROWS_AS(cxxmpi::cart_comm(world, grid_dims, periods,
+                                      std::span<const int>{line}),
+                    std::invalid_argument);
+  }
+}
@@ -0,0 +1,108 @@
+#include <array>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <cxxmpi/comm.hpp>
+#include <cxxmpi/dist_graph_comm.hpp>
+
+// NOLINTNEXTLINE
+TEST_CASE("Distributed graph communicator", "[mpi][dist_graph]") {
+  using namespace cxxmpi;  // NOLINT
+  auto const rank = comm_world().rank();
+  auto const nprocs = static_cast<int>(comm_world().size());
+  auto const left = (rank + nprocs - 1) % nprocs;
+  auto const right = (rank + 1) % nprocs;
+
+  // Directed ring with a self loop; no edge is duplicated for two or more
+  // processes, so every block has a unique destination
+  const std::array sources = {left, rank};
+  const std::array destinations = {right, rank};
+  auto graph = dist_graph_comm(comm_world(), sources, destinations);
+  auto const me = graph.rank();
+
+  SECTION("Topology queries") {
+    CHECK(graph.in_degree() == 2);
+    CHECK(graph.out_degree() == 2);
+    CHECK(graph.sources() == std::vector{left, rank});
+    CHECK(graph.destinations() == std::vector{right, rank});
+
+    auto const weak = weak_dist_graph_comm{graph};
+    CHECK(weak.native() == graph.native());
+  }
+
+  SECTION("Blocking neighbor allgather and alltoall") {
+    const std::array out = {me, me * 10};
+    std::array<int, 4> in = {};
+    graph.neighbor_allgather(std::span<const int>{out}, std::span{in});
+    CHECK(in == std::array{left, left * 10, me, me * 10});
+
+    // Block i goes to destination i
+    const std::array blocks = {me * 10 + 1, me * 10 + 2};
+    std::array<int, 2> got = {};
+    graph.neighbor_alltoall(std::span<const int>{blocks}, std::span{got});
+    CHECK(got == std::array{left * 10 + 1, me * 10 + 2});
+  }
+
+  SECTION("Neighbor alltoallv with uneven counts") {
+    // One value to the right, two to this process
+    const std::array out = {me, me + 100, me + 100};
+    const std::array counts = {1, 2};
+    const std::array displs = {0, 1};
+    std::array<int, 3> in = {};
+
+    graph.neighbor_alltoallv(std::span<const int>{out}, counts, displs,
+                             std::span{in}, counts, displs);
+    CHECK(in == std::array{left, me + 100, me + 100});
+
+    in = {};
+    auto req = graph.ineighbor_alltoallv(std::span<const int>{out}, counts,
+                                         displs, std::span{in}, counts,
+                                         displs);
+    req.wait();
+    CHECK(in == std::array{left, me + 100, me + 100});
+  }
+
+  SECTION("Persistent neighbor collectives") {
+    std::array<int, 1> out = {};
+    std::array<int, 2> in = {};
+    auto gather = graph.neighbor_allgather_init(std::span<const int>{out},
+                                                std::span{in});
+
+    std::array<int, 2> blocks = {};
+    const std::array counts = {1, 1};
+    const std::array displs = {0, 1};
+    std::array<int, 2> got = {};
+    auto exchange = graph.neighbor_alltoallv_init(
+        std::span<const int>{blocks}, counts, displs, std::span{got}, counts,
+        displs);
+
+    for (int iteration = 0; iteration < 3; ++iteration) {
+      out = {me + iteration};
+      blocks = {me * 10 + iteration, me * 20 + iteration};
+      gather.start();
+      exchange.start();
+      gather.wait();
+      exchange.wait();
+      CHECK(in == std::array{left + iteration, me + iteration});
+      CHECK(got == std::array{left * 10 + iteration, me * 20 + iteration});
+    }
+  }
+
+  SECTION("Nonblocking neighbor allgather") {
+    const std::array out = {me};
+    std::array<int, 2> in = {};
+    auto req = graph.ineighbor_allgather(std::span<const int>{out},
+                                         std::span{in});
+    req.wait();
+    CHECK(in == std::array{left, me});
+  }
+
+  SECTION("Weights must match the neighbors") {
+    const std::array weights = {1};
+    CHECK_THROWS_AS(
+        dist_graph_comm(comm_world(), sources, weights, destinations, weights),
+        std::invalid_argument);
+  }
+}
@@ -0,0 +1,105 @@
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <cxxmpi/comm.hpp>
+#include <cxxmpi/distributed_unordered_map.hpp>
+
+namespace {
+
+// Sends every key to one of two slots, so most inserts must probe
+struct colliding_hash {
+  auto operator()(int key) const noexcept -> std::size_t {
+    return static_cast<std::size_t>(key % 2);
+  }
+};
+
+}  // namespace
+
+// NOLINTNEXTLINE
+TEST_CASE("Distributed unordered map", "[mpi][distributed_unordered_map]") {
+  using namespace cxxmpi;  // NOLINT
+  auto const me = comm_world().rank();
+  auto const nprocs = static_cast<int>(comm_world().size());
+  constexpr int own = 20;
+  constexpr int shared = 10;
+
+  // Keys private to each process plus keys every process inserts
+  auto const batch = [me] {
+    std::vector<int> keys;
+    for (int i = 0; i < own; ++i) {
+      keys.push_back(me * 100 + i);
+    }
+    for (int i = 0; i < shared; ++i) {
+      keys.push_back(1'000'000 + i);
+    }
+    return keys;
+  }();
+  std::vector<double> values;
+  for (auto const key : batch) {
+    values.push_back(static_cast<double>(key) * 2.0);
+  }
+
+  SECTION("Batched insert deduplicates and find sees remote keys") {
+    auto map = distributed_unordered_map<int, double>{comm_world(), 64};
+    CHECK(map.capacity() == 64);
+    auto const inserted = map.insert(std::span<const int>{batch},
+                                     std::span<const double>{values});
+    CHECK(comm_world().allreduce(inserted, std::plus<>{}) ==
+          static_cast<std::size_t>(nprocs * own + shared));
+    comm_world().barrier();
+    CHECK(comm_world().allreduce(map.local_size(), std::plus<>{}) ==
+          static_cast<std::size_t>(nprocs * own + shared));
+
+    auto const right = (me + 1) % nprocs;
+    const std::array queries = {right * 100 + 7, 1'000'000 + 3,
+                                right * 100 + own};
+    auto const found = map.find(std::span<const int>{queries});
+    REQUIRE(found.size() == 3);
+    REQUIRE(found[0].has_value());
+    CHECK(static_cast<int>(*found[0]) == 2 * (right * 100 + 7));
+    REQUIRE(found[1].has_value());
+    CHECK(static_cast<int>(*found[1]) == 2'000'006);
+    CHECK_FALSE(found[2].has_value());
+    CHECK(map.contains(me * 100));
+  }
+
+  SECTION("Colliding keys probe linearly") {
+    auto map =
+        distributed_unordered_map<int, int, colliding_hash>{comm_world(), 32};
+    std::vector<int> keys;
+    std::vector<int> doubled;
+    for (int i = 0; i < 8; ++i) {
+      keys.push_back(me * 8 + i);
+      doubled.push_back(2 * (me * 8 + i));
+    }
+    CHECK(map.insert(std::span<const int>{keys},
+                     std::span<const int>{doubled}) == keys.size());
+    comm_world().barrier();
+
+    for (int key = 0; key < nprocs * 8; ++key) {
+      CHECK(map.find(key) == std::optional{2 * key});
+    }
+    CHECK_FALSE(map.find(nprocs * 8).has_value());
+
+    // Overwrites keep the key count
+    CHECK_FALSE(map.insert(me * 8, -1));
+    comm_world().barrier();
+    CHECK(map.find(me * 8) == std::optional{-1});
+  }
+
+  SECTION("Full tables and the empty key are rejected") {
+    auto map = distributed_unordered_map<int, int>{comm_self(), 2, -1};
+    CHECK(map.insert(1, 1));
+    CHECK(map.insert(2, 2));
+    CHECK_THROWS_AS(map.insert(3, 3), std::length_error);
+    CHECK_THROWS_AS(map.insert(-1, 0), std::invalid_argument);
+    CHECK_THROWS_AS((distributed_unordered_map<int, int>{comm_self(), 0}),
+                    std::invalid_argument);
+  }
+}
@@ -0,0 +1,114 @@
+#include <array>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <cxxmpi/comm.hpp>
+#include <cxxmpi/exchange_plan.hpp>
+#include <mpi.h>
+
+// NOLINTNEXTLINE
+TEST_CASE("Alltoall collectives", "[mpi][collective][alltoall]") {
+  const auto& comm = cxxmpi::comm_world();
+  const int rank = comm.rank();
+  const auto size = comm.size();
+
+  SECTION("Alltoall with builtin datatype") {
+    std::vector<int> send_data(size * 2);
+    for (std::size_t i = 0; i < send_data.size(); ++i) {
+      send_data[i] = rank * 100 + static_cast<int>(i / 2);
+    }
+    std::vector<int> recv_data(size * 2);
+    comm.alltoall(std::span<const int>{send_data}, std::span{recv_data});
+    for (std::size_t i = 0; i < recv_data.size(); ++i) {
+      CHECK(recv_data[i] == static_cast<int>(i / 2) * 100 + rank);
+    }
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("Exchange plan", "[mpi][collective][alltoall]") {
+  const auto& comm = cxxmpi::comm_world();
+  const int rank = comm.rank();
+  const auto size = comm.size();
+
+  // rank r sends (dest + 1 + shift) copies of r to every dest
+  auto const make_counts = [size](int shift) {
+    std::vector<int> counts(size);
+    for (std::size_t dest = 0; dest < size; ++dest) {
+      counts[dest] = static_cast<int>(dest) + 1 + shift;
+    }
+    return counts;
+  };
+
+  auto const check_received = [&](const cxxmpi::exchange_plan& plan,
+                                  const std::vector<int>& recv_data,
+                                  int shift) {
+    REQUIRE(recv_data.size() == plan.recv_size());
+    for (std::size_t src = 0; src < size; ++src) {
+      CHECK(plan.recv_counts()[src] == rank + 1 + shift);
+      auto const offset = static_cast<std::size_t>(plan.recv_displs()[src]);
+      for (int i = 0; i < plan.recv_counts()[src]; ++i) {
+        CHECK(recv_data[offset + static_cast<std::size_t>(i)]
+              == static_cast<int>(src));
+      }
+    }
+  };
+
+  auto plan = cxxmpi::exchange_plan{comm};
+
+  SECTION("Alltoallv reuses counts across iterations") {
+    for (int iteration = 0; iteration < 3; ++iteration) {
+      auto const shift = iteration == 2 ? 1 : 0;
+      auto const changed = plan.set_send_counts(make_counts(shift));
+      CHECK(changed == (iteration != 1));
+      plan.exchange_counts(comm);
+
+      std::vector<int> send_data(plan.send_size(), rank);
+      std::vector<int> recv_data(plan.recv_size(), -1);
+      plan.alltoallv(comm, std::span<const int>{send_data},
+                     std::span{recv_data});
+      check_received(plan, recv_data, shift);
+    }
+  }
+
+  SECTION("Nonblocking alltoallv owns its counts") {
+    plan.set_send_counts(make_counts(0));
+    plan.exchange_counts(comm);
+    std::vector<int> send_data(plan.send_size(), rank);
+    std::vector<int> recv_data(plan.recv_size(), -1);
+    auto req = plan.ialltoallv(comm, std::span<const int>{send_data},
+                               std::span{recv_data});
+
+    // Changing the plan does not affect the exchange in flight
+    auto const copy = plan;
+    plan.set_send_counts(make_counts(1));
+    plan.set_recv_counts(make_counts(1));
+    req.wait_without_status();
+    check_received(copy, recv_data, 0);
+  }
+
+  SECTION("Byte displacements beyond int are rejected") {
+    auto two = cxxmpi::exchange_plan{2};
+    const std::array types = {MPI_DOUBLE, MPI_DOUBLE};
+    two.set_send_types(types);
+    const std::array counts = {300'000'000, 1};
+    CHECK_THROWS_AS(two.set_send_counts(counts), std::overflow_error);
+  }
+
+  SECTION("Alltoallw with cached datatypes") {
+    plan.set_send_counts(make_counts(0));
+    plan.exchange_counts(comm);
+    auto const types = std::vector<MPI_Datatype>(size, MPI_INT);
+    CHECK(plan.set_send_types(types));
+    CHECK(plan.set_recv_types(types));
+    CHECK_FALSE(plan.set_send_types(types));
+
+    std::vector<int> send_data(plan.send_size(), rank);
+    std::vector<int> recv_data(plan.recv_size(), -1);
+    plan.alltoallw(comm, send_data.data(), recv_data.data());
+    check_received(plan, recv_data, 0);
+  }
+}
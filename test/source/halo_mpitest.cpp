@@ -0,0 +1,138 @@
+#include <array>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <cxxmpi/cart_comm.hpp>
+#include <cxxmpi/comm.hpp>
+#include <cxxmpi/dims.hpp>
+#include <cxxmpi/halo.hpp>
+
+namespace {
+
+// Value of a padded cell (i, j) owned by rank
+auto cell_value(int rank, int i, int j) -> int {
+  return rank * 10000 + i * 100 + j;
+}
+
+}  // namespace
+
+// NOLINTNEXTLINE
+TEST_CASE("Halo exchange on a cartesian grid", "[mpi][halo]") {
+  using namespace cxxmpi;  // NOLINT
+  auto const nprocs = static_cast<int>(comm_world().size());
+
+  SECTION("2D periodic grid fills faces, edges and corners") {
+    auto const grid = create_dims(nprocs, 2);
+    auto cart = cart_comm(comm_world(),
+                          {static_cast<size_t>(grid[0]),
+                           static_cast<size_t>(grid[1])},
+                          {true, true}, false);
+    constexpr int rows = 3;
+    constexpr int cols = 4;
+    constexpr int ghost = 1;
+    constexpr int padded_rows = rows + 2 * ghost;
+    constexpr int padded_cols = cols + 2 * ghost;
+    const std::array extents = {rows, cols};
+
+    std::vector<int> field(padded_rows * padded_cols, -1);
+    auto halo = halo_exchanger<int>{cart, std::span{field}, extents, ghost};
+    REQUIRE(halo.neighbor_count() == 8);
+
+    auto const me = cart.rank();
+    auto const coords = cart.coords();
+    for (int iteration = 0; iteration < 2; ++iteration) {
+      for (int i = ghost; i < rows + ghost; ++i) {
+        for (int j = ghost; j < cols + ghost; ++j) {
+          field[static_cast<size_t>(i * padded_cols + j)] =
+              cell_value(me, i, j) + iteration;
+        }
+      }
+
+      halo.begin();
+      CHECK(halo.active());
+      halo.end();
+      CHECK_FALSE(halo.active());
+
+      for (int i = 0; i < padded_rows; ++i) {
+        for (int j = 0; j < padded_cols; ++j) {
+          auto const step_i = i < ghost ? -1 : (i >= rows + ghost ? 1 : 0);
+          auto const step_j = j < ghost ? -1 : (j >= cols + ghost ? 1 : 0);
+          auto const owner =
+              cart.rank({(coords[0] + step_i + grid[0]) % grid[0],
+                         (coords[1] + step_j + grid[1]) % grid[1]});
+          auto const value = cell_value(owner, i - step_i * rows,
+                                        j - step_j * cols) +
+                             iteration;
+          CHECK(field[static_cast<size_t>(i * padded_cols + j)] == value);
+        }
+      }
+    }
+  }
+
+  SECTION("Open chain leaves boundary ghosts untouched") {
+    auto cart = cart_comm(comm_world(), {static_cast<size_t>(nprocs)},
+                          {false}, false);
+    constexpr int cells = 4;
+    constexpr int ghost = 2;
+    const std::array extents = {cells};
+    std::vector<double> line(cells + 2 * ghost, -1.0);
+    auto halo = halo_exchanger<double>{cart, std::span{line}, extents, ghost};
+
+    auto const me = cart.rank();
+    auto const last = nprocs - 1;
+    CHECK(halo.neighbor_count() ==
+          static_cast<size_t>((me > 0 ? 1 : 0) + (me < last ? 1 : 0)));
+
+    for (int j = ghost; j < cells + ghost; ++j) {
+      line[static_cast<size_t>(j)] = me * 10 + j;
+    }
+    halo.exchange();
+
+    for (int j = 0; j < ghost; ++j) {
+      auto const left = me > 0 ? (me - 1) * 10 + j + cells : -1;
+      CHECK(static_cast<int>(line[static_cast<size_t>(j)]) == left);
+      auto const k = cells + ghost + j;
+      auto const right = me < last ? (me + 1) * 10 + k - cells : -1;
+      CHECK(static_cast<int>(line[static_cast<size_t>(k)]) == right);
+    }
+  }
+
+  SECTION("Invalid layouts are rejected") {
+    auto cart = cart_comm(comm_world(), {static_cast<size_t>(nprocs)},
+                          {true}, false);
+    std::vector<int> line(6);
+    const std::array extents = {4};
+    const std::array too_small = {1};
+    CHECK_THROWS_AS(
+        (halo_exchanger<int>{cart, std::span{line}, too_small, 2}),
+        std::invalid_argument);
+    CHECK_THROWS_AS((halo_exchanger<int>{cart, std::span{line}, extents, 2}),
+                    std::invalid_argument);
+    auto halo = halo_exchanger<int>{cart, std::span{line}, extents, 1};
+    CHECK_THROWS_AS(halo.end(), std::logic_error);
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("Halo exchange without neighbors", "[mpi][halo]") {
+  using namespace cxxmpi;  // NOLINT
+  // A single-process open chain has no neighbor in either direction
+  auto cart = cart_comm(comm_self(), {1}, {false}, false);
+  const std::array extents = {3};
+  std::vector<int> line = {-1, 1, 2, 3, -1};
+  auto halo = halo_exchanger<int>{cart, std::span{line}, extents, 1};
+  REQUIRE(halo.neighbor_count() == 0);
+
+  halo.begin();
+  CHECK(halo.active());
+  CHECK_THROWS_AS(halo.begin(), std::logic_error);
+  halo.end();
+  CHECK_FALSE(halo.active());
+  CHECK_THROWS_AS(halo.end(), std::logic_error);
+
+  halo.exchange();
+  CHECK(line == std::vector{-1, 1, 2, 3, -1});
+}
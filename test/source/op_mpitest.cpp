@@ -0,0 +1,183 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <cxxmpi/comm.hpp>
+#include <cxxmpi/dtype.hpp>
+#include <cxxmpi/op.hpp>
+#include <mpi.h>
+
+namespace {
+struct value_loc {
+  double value;
+  int loc;
+};
+}  // namespace
+
+TEST_CASE("MPI Op basic operations", "[mpi][op]") {
+  SECTION("weak_op from builtin functors") {
+    auto sum = cxxmpi::as_weak_op<std::plus<>>();
+    CHECK(sum.native() == MPI_SUM);
+    CHECK(sum.commutative());
+  }
+
+  SECTION("User-defined operator creation") {
+    auto op = cxxmpi::op{
+        [](const int& in, const int& inout) -> int { return in + inout; }};
+    CHECK(op.native() != MPI_OP_NULL);
+    CHECK(op.commutative());
+  }
+
+  SECTION("Move and weak conversion") {
+    auto op = cxxmpi::op{
+        [](const int& in, const int& inout) -> int { return in | inout; },
+        false};
+    const auto native = op.native();
+    auto moved = std::move(op);
+    CHECK(moved.native() == native);
+    CHECK_FALSE(moved.commutative());
+
+    auto weak = cxxmpi::weak_op{moved};
+    CHECK(weak.native() == native);
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("User-defined reductions", "[mpi][op][collective]") {
+  const auto& comm = cxxmpi::comm_world();
+  const int rank = comm.rank();
+  const int size = static_cast<int>(comm.size());
+
+  SECTION("Bitwise merge over integers") {
+    auto merge = cxxmpi::op{
+        [](const std::uint32_t& in, const std::uint32_t& inout) noexcept {
+          return in | inout;
+        }};
+    std::array<unsigned, 2> bits = {1U << static_cast<unsigned>(rank), 0U};
+    comm.allreduce(std::span{bits}, merge);
+    CHECK(bits[0] == (1U << static_cast<unsigned>(size)) - 1U);
+    CHECK(bits[1] == 0U);
+  }
+
+  SECTION("Min-loc over a struct") {
+    auto const types = std::array{MPI_DOUBLE, MPI_INT};
+    auto const blocklengths = std::array{1, 1};
+    auto const displacements =
+        std::array<MPI_Aint, 2>{offsetof(value_loc, value),
+                                offsetof(value_loc, loc)};
+    auto struct_type = cxxmpi::dtype{blocklengths, displacements, types};
+    struct_type.commit();
+
+    auto minloc = cxxmpi::op{
+        [](const value_loc& in, const value_loc& inout) -> value_loc {
+          return in.value < inout.value ? in : inout;
+        }};
+
+    const value_loc mine{.value = 10.0 - rank, .loc = rank};
+    value_loc result{};
+    comm.allreduce(std::span<const value_loc, 1>{&mine, 1},
+                   std::span<value_loc, 1>{&result, 1},
+                   cxxmpi::weak_dtype{struct_type}, 1,
+                   cxxmpi::weak_op{minloc});
+    CHECK(result.loc == size - 1);
+    CHECK(static_cast<int>(result.value) == 10 - (size - 1));
+  }
+
+  SECTION("Non-commutative operator keeps rank order") {
+    // Digit concatenation: {digits, 10^len}. Associative, not commutative.
+    using digits = std::array<std::int64_t, 2>;
+    auto concat = cxxmpi::op{
+        [](const digits& in, const digits& inout) -> digits {
+          return {in[0] * inout[1] + inout[0], in[1] * inout[1]};
+        },
+        false};
+    auto digits_type =
+        cxxmpi::dtype{cxxmpi::weak_dtype{cxxmpi::weak_dtype_handle{
+                          MPI_INT64_T}},
+                      2};
+    digits_type.commit();
+
+    const digits mine = {rank + 1, 10};
+    digits result = {};
+    comm.reduce(std::span<const digits, 1>{&mine, 1},
+                std::span<digits, 1>{&result, 1},
+                cxxmpi::weak_dtype{digits_type}, 1, concat, 0);
+    if (rank == 0) {
+      std::int64_t expected = 0;
+      for (int i = 1; i <= size; ++i) {
+        expected = expected * 10 + i;
+      }
+      CHECK(result[0] == expected);
+    }
+  }
+
+  SECTION("Derived types with scans and nonblocking collectives") {
+    using digits = std::array<std::int64_t, 2>;
+    auto concat = cxxmpi::op{
+        [](const digits& in, const digits& inout) -> digits {
+          return {in[0] * inout[1] + inout[0], in[1] * inout[1]};
+        },
+        false};
+    auto digits_type =
+        cxxmpi::dtype{cxxmpi::weak_dtype{cxxmpi::weak_dtype_handle{
+                          MPI_INT64_T}},
+                      2};
+    digits_type.commit();
+    const auto data_type = cxxmpi::weak_dtype{digits_type};
+
+    // Concatenation of the digits 1..n
+    auto const prefix = [](int n) {
+      std::int64_t value = 0;
+      for (int i = 1; i <= n; ++i) {
+        value = value * 10 + i;
+      }
+      return value;
+    };
+
+    const digits mine = {rank + 1, 10};
+    const auto send_data = std::span<const digits, 1>{&mine, 1};
+    digits inclusive = mine;
+    comm.scan(std::span<digits, 1>{&inclusive, 1}, data_type, 1, concat);
+    CHECK(inclusive[0] == prefix(rank + 1));
+
+    digits exclusive = mine;
+    comm.exscan(std::span<digits, 1>{&exclusive, 1}, data_type, 1, concat);
+    if (rank > 0) {
+      CHECK(exclusive[0] == prefix(rank));
+    }
+
+    digits scanned = {};
+    digits exscanned = {};
+    digits reduced = {};
+    auto scan_req = comm.iscan(send_data, std::span<digits, 1>{&scanned, 1},
+                               data_type, 1, concat);
+    auto exscan_req = comm.iexscan(
+        send_data, std::span<digits, 1>{&exscanned, 1}, data_type, 1, concat);
+    auto reduce_req = comm.ireduce(
+        send_data, std::span<digits, 1>{&reduced, 1}, data_type, 1, concat, 0);
+    scan_req.wait_without_status();
+    exscan_req.wait_without_status();
+    reduce_req.wait_without_status();
+    CHECK(scanned[0] == prefix(rank + 1));
+    if (rank > 0) {
+      CHECK(exscanned[0] == prefix(rank));
+    }
+    if (rank == 0) {
+      CHECK(reduced[0] == prefix(size));
+    }
+
+    std::vector<digits> gathered(static_cast<std::size_t>(size));
+    comm.igather(send_data, std::span{gathered}, data_type, 1, 0)
+        .wait_without_status();
+    if (rank == 0) {
+      for (int r = 0; r < size; ++r) {
+        CHECK(gathered[static_cast<std::size_t>(r)] == digits{r + 1, 10});
+      }
+    }
+  }
+}
@@ -0,0 +1,109 @@
+#include <array>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <cxxmpi/comm.hpp>
+#include <cxxmpi/partitioned.hpp>
+#include <cxxmpi/universe.hpp>
+#include <mpi.h>
+
+// NOLINTNEXTLINE
+TEST_CASE("Partitioned point-to-point transfer", "[mpi][partitioned]") {
+  const auto& comm = cxxmpi::comm_world();
+  const int rank = comm.rank();
+  const int size = static_cast<int>(comm.size());
+  const int right = (rank + 1) % size;
+  const int left = (rank + size - 1) % size;
+
+  SECTION("Partitions marked ready out of order") {
+    std::array<int, 8> send_buf = {};
+    std::array<int, 8> recv_buf = {};
+    cxxmpi::partitioned_send<int> psend{comm, std::span{send_buf}, 4, right,
+                                        5};
+    cxxmpi::partitioned_recv<int> precv{comm, std::span{recv_buf}, 4, left,
+                                        5};
+    REQUIRE(psend.partitions() == 4);
+    REQUIRE(psend.partition(3).size() == 2);
+
+    for (int iteration = 0; iteration < 2; ++iteration) {
+      precv.start();
+      psend.start();
+      for (std::size_t i = psend.partitions(); i-- > 0;) {
+        auto part = psend.partition(i);
+        part[0] = rank;
+        part[1] = iteration * 10 + static_cast<int>(i);
+        psend.pready(i);
+      }
+      for (std::size_t i = 0; i < precv.partitions(); ++i) {
+        while (!precv.parrived(i)) {
+        }
+        auto part = precv.partition(i);
+        CHECK(part[0] == left);
+        CHECK(part[1] == iteration * 10 + static_cast<int>(i));
+      }
+      precv.wait();
+      psend.wait();
+      CHECK_FALSE(psend.active());
+    }
+  }
+
+  SECTION("Buffer must divide evenly into partitions") {
+    std::array<int, 5> buf = {};
+    CHECK_THROWS_AS(
+        cxxmpi::partitioned_send<int>(comm, std::span{buf}, 2, right),
+        std::invalid_argument);
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("Partitions marked ready from worker threads",
+          "[mpi][partitioned]") {
+  if (cxxmpi::universe::thread_level() < MPI_THREAD_MULTIPLE) {
+    SKIP("This test requires MPI_THREAD_MULTIPLE");
+  }
+
+  const auto& comm = cxxmpi::comm_world();
+  const int rank = comm.rank();
+  const int size = static_cast<int>(comm.size());
+  const int right = (rank + 1) % size;
+  const int left = (rank + size - 1) % size;
+
+  constexpr std::size_t workers = 4;
+  constexpr std::size_t per_partition = 16;
+  std::vector<int> send_buf(workers * per_partition);
+  std::vector<int> recv_buf(workers * per_partition, -1);
+  cxxmpi::partitioned_send<int> psend{comm, std::span{send_buf}, workers,
+                                      right, 7};
+  cxxmpi::partitioned_recv<int> precv{comm, std::span{recv_buf}, workers,
+                                      left, 7};
+
+  for (int iteration = 0; iteration < 3; ++iteration) {
+    precv.start();
+    psend.start();
+    {
+      // Each worker packs and marks its own partition
+      std::vector<std::jthread> threads;
+      for (std::size_t w = 0; w < workers; ++w) {
+        threads.emplace_back([&psend, rank, iteration, w] {
+          auto part = psend.partition(w);
+          for (std::size_t k = 0; k < part.size(); ++k) {
+            part[k] = rank * 1000 + iteration * 100 +
+                      static_cast<int>(w * per_partition + k);
+          }
+          psend.pready(w);
+        });
+      }
+    }
+    precv.wait();
+    psend.wait();
+
+    for (std::size_t k = 0; k < recv_buf.size(); ++k) {
+      CHECK(recv_buf[k] ==
+            left * 1000 + iteration * 100 + static_cast<int>(k));
+    }
+  }
+}
@@ -0,0 +1,60 @@
+#include <array>
+#include <cstddef>
+#include <span>
+
+#include <catch2/catch_test_macros.hpp>
+#include <cxxmpi/comm.hpp>
+#include <cxxmpi/persistent_channel.hpp>
+#include <mpi.h>
+
+// NOLINTNEXTLINE
+TEST_CASE("Persistent point-to-point channels", "[mpi][persistent]") {
+  const auto& comm = cxxmpi::comm_world();
+  const int rank = comm.rank();
+  const int size = static_cast<int>(comm.size());
+  const int right = (rank + 1) % size;
+  const int left = (rank + size - 1) % size;
+
+  SECTION("Single channel pair reused across iterations") {
+    std::array<int, 2> send_buf = {};
+    std::array<int, 2> recv_buf = {};
+    auto send = comm.send_init(std::span<const int>{send_buf}, right, 3);
+    auto recv = comm.recv_init(std::span{recv_buf}, left, 3);
+
+    for (int iteration = 0; iteration < 4; ++iteration) {
+      send_buf = {rank, iteration};
+      recv.start();
+      send.start();
+      CHECK(recv.active());
+      auto st = recv.wait();
+      send.wait();
+      CHECK(st.source() == left);
+      CHECK(recv_buf == std::array{left, iteration});
+    }
+  }
+
+  SECTION("Ring exchange with one start and one wait per iteration") {
+    std::array<double, 4> to_left = {};
+    std::array<double, 4> to_right = {};
+    std::array<double, 4> from_left = {};
+    std::array<double, 4> from_right = {};
+
+    cxxmpi::channel_group halo{4};
+    halo.add(comm.recv_init(std::span{from_left}, left, 0));
+    halo.add(comm.recv_init(std::span{from_right}, right, 1));
+    halo.add(comm.send_init(std::span<const double>{to_right}, right, 0));
+    halo.add(comm.send_init(std::span<const double>{to_left}, left, 1));
+    REQUIRE(halo.size() == 4);
+
+    for (int iteration = 0; iteration < 3; ++iteration) {
+      to_left.fill(rank * 10 + iteration);
+      to_right.fill(rank * 10 + iteration + 1);
+      halo.start_all();
+      CHECK(halo.active());
+      halo.wait_all();
+      CHECK_FALSE(halo.active());
+      CHECK(static_cast<int>(from_left[0]) == left * 10 + iteration + 1);
+      CHECK(static_cast<int>(from_right[3]) == right * 10 + iteration);
+    }
+  }
+}
@@ -0,0 +1,98 @@
+#include <array>
+#include <functional>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <cxxmpi/comm.hpp>
+#include <cxxmpi/persistent_collective.hpp>
+#include <cxxmpi/request.hpp>
+#include <mpi.h>
+
+// NOLINTNEXTLINE
+TEST_CASE("Persistent collectives", "[mpi][collective][persistent]") {
+  const auto& comm = cxxmpi::comm_world();
+  const int rank = comm.rank();
+  const int size = static_cast<int>(comm.size());
+
+#if defined(CXXMPI_HAS_PERSISTENT_COLLECTIVES)
+  constexpr bool native_persistent = true;
+#else
+  constexpr bool native_persistent = false;
+#endif
+
+  SECTION("Allreduce started repeatedly on the same buffers") {
+    std::array<int, 2> send_data = {};
+    std::array<int, 2> recv_data = {};
+    auto allreduce = comm.allreduce_init(std::span<const int>{send_data},
+                                         std::span{recv_data}, std::plus<>{});
+    CHECK(allreduce.persistent() == native_persistent);
+
+    for (int iteration = 0; iteration < 5; ++iteration) {
+      send_data = {iteration, rank};
+      allreduce.start();
+      CHECK(allreduce.active());
+      allreduce.wait();
+      CHECK_FALSE(allreduce.active());
+      CHECK(recv_data == std::array{iteration * size, size * (size - 1) / 2});
+    }
+  }
+
+  SECTION("In-place allreduce and bcast") {
+    std::array<double, 1> residual = {};
+    auto allreduce = comm.allreduce_init(std::span{residual}, std::plus<>{});
+    int value = 0;
+    auto bcast = comm.bcast_init(std::span<int, 1>{&value, 1}, size - 1);
+
+    for (int iteration = 0; iteration < 3; ++iteration) {
+      residual[0] = 1.0;
+      value = rank == size - 1 ? iteration : -1;
+      allreduce.start();
+      bcast.start();
+      allreduce.wait_without_status();
+      while (!bcast.test()) {
+      }
+      CHECK(static_cast<int>(residual[0]) == size);
+      CHECK(value == iteration);
+    }
+  }
+
+  SECTION("Alltoallv completed through a request_group") {
+    std::vector<int> counts(comm.size(), 1);
+    std::vector<int> displs(comm.size());
+    std::iota(displs.begin(), displs.end(), 0);
+    std::vector<int> send_data(comm.size());
+    std::vector<int> recv_data(comm.size());
+    auto alltoallv = comm.alltoallv_init(
+        std::span<const int>{send_data}, std::span<const int>{counts},
+        std::span<const int>{displs}, std::span{recv_data},
+        std::span<const int>{counts}, std::span<const int>{displs});
+
+    for (int iteration = 0; iteration < 3; ++iteration) {
+      std::ranges::fill(send_data, rank + iteration);
+      cxxmpi::request_group group;
+      alltoallv.start(group);
+      group.wait_all_without_status();
+      for (int src = 0; src < size; ++src) {
+        CHECK(recv_data[static_cast<size_t>(src)] == src + iteration);
+      }
+    }
+  }
+
+  SECTION("Empty collectives cannot be started") {
+    cxxmpi::persistent_collective empty;
+    CHECK_FALSE(empty.persistent());
+    CHECK_FALSE(empty.active());
+    CHECK_THROWS_AS(empty.start(), std::logic_error);
+
+    std::array<int, 1> value = {rank};
+    auto allreduce = comm.allreduce_init(std::span{value}, std::plus<>{});
+    auto moved = std::move(allreduce);
+    CHECK(moved.persistent() == native_persistent);
+    // NOLINTNEXTLINE(bugprone-use-after-move)
+    CHECK_FALSE(allreduce.persistent());
+  }
+}
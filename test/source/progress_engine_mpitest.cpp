@@ -0,0 +1,95 @@
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <cxxmpi/comm.hpp>
+#include <cxxmpi/progress_engine.hpp>
+#include <cxxmpi/status.hpp>
+#include <cxxmpi/universe.hpp>
+#include <mpi.h>
+
+// NOLINTNEXTLINE
+TEST_CASE("Background progress engine", "[mpi][progress]") {
+  if (cxxmpi::universe::thread_level() < MPI_THREAD_MULTIPLE) {
+    SKIP("This test requires MPI_THREAD_MULTIPLE");
+  }
+
+  const auto& comm = cxxmpi::comm_world();
+  const int rank = comm.rank();
+  const int size = static_cast<int>(comm.size());
+  const int right = (rank + 1) % size;
+  const int left = (rank + size - 1) % size;
+
+  SECTION("Callbacks fire for submitted operations") {
+    constexpr std::size_t num_messages = 32;
+    std::vector<int> out(num_messages);
+    std::vector<int> in(num_messages, -1);
+    std::atomic<int> received{0};
+    std::atomic<int> wrong_source{0};
+
+    cxxmpi::progress_engine engine{
+        {.spin_polls = 8,
+         .min_sleep = std::chrono::microseconds{1},
+         .max_sleep = std::chrono::microseconds{50}}};
+    for (std::size_t i = 0; i < num_messages; ++i) {
+      const int tag = static_cast<int>(i);
+      out[i] = rank * 100 + tag;
+      engine.submit(comm.irecv(std::span{in}.subspan(i, 1), left, tag),
+                    [&, left](const cxxmpi::status& st) {
+                      if (st.source() != left) {
+                        ++wrong_source;
+                      }
+                      ++received;
+                    });
+      engine.submit(
+          comm.isend(std::span<const int>{out}.subspan(i, 1), right, tag));
+    }
+    engine.wait_idle();
+    CHECK(engine.pending() == 0);
+    CHECK(received == static_cast<int>(num_messages));
+    CHECK(wrong_source == 0);
+    for (std::size_t i = 0; i < num_messages; ++i) {
+      CHECK(in[i] == left * 100 + static_cast<int>(i));
+    }
+  }
+
+  SECTION("Completed persistent requests are retired") {
+    std::array<int, 1> out = {};
+    std::array<int, 1> in = {-1};
+    auto recv_channel = comm.recv_init(std::span{in}, left, 40);
+    auto send_channel = comm.send_init(std::span<const int>{out}, right, 40);
+
+    cxxmpi::progress_engine engine;
+    for (int iteration = 0; iteration < 3; ++iteration) {
+      out[0] = rank * 10 + iteration;
+      recv_channel.start();
+      send_channel.start();
+      engine.submit(cxxmpi::request{recv_channel.native()});
+      engine.submit(cxxmpi::request{send_channel.native()});
+      engine.wait_idle();
+      // The engine no longer polls the inactive handles, so the channels
+      // can be completed and restarted
+      recv_channel.wait();
+      send_channel.wait();
+      CHECK(in[0] == left * 10 + iteration);
+    }
+    // Returns only once no slot is left
+    engine.stop();
+  }
+
+  SECTION("Callback errors are reported by stop") {
+    std::array<int, 1> value = {rank};
+    cxxmpi::progress_engine engine;
+    engine.submit(comm.iallreduce(std::span{value}, std::plus<>{}),
+                  [](const cxxmpi::status&) {
+                    throw std::runtime_error("callback failed");
+                  });
+    CHECK_THROWS_AS(engine.stop(), std::runtime_error);
+    CHECK(value[0] == size * (size - 1) / 2);
+  }
+}
@@ -0,0 +1,169 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <cxxmpi/comm.hpp>
+#include <cxxmpi/window.hpp>
+
+// NOLINTNEXTLINE
+TEST_CASE("Shared-memory windows", "[mpi][window]") {
+  using namespace cxxmpi;  // NOLINT
+  auto node = comm_world().split_type(split_kind::shared);
+  auto const me = node.rank();
+
+  SECTION("One table per node") {
+    constexpr std::size_t entries = 64;
+    auto table = shared_window<int>{node, me == 0 ? entries : 0};
+    CHECK(table.local().size() == (me == 0 ? entries : 0));
+    REQUIRE(table.segment(0).size() == entries);
+
+    if (me == 0) {
+      std::iota(table.local().begin(), table.local().end(), 0);
+    }
+    table.fence();
+    auto const view = table.segment(0);
+    CHECK(std::ranges::equal(view, std::views::iota(0, 64)));
+    table.fence();
+  }
+
+  SECTION("Neighbors read each other's segments with loads") {
+    auto window = shared_window<double>{node, 2};
+    REQUIRE(window.segments().size() == node.size());
+    window.local()[0] = me;
+    window.local()[1] = me * 2.0;
+    window.fence();
+
+    auto const n = static_cast<int>(node.size());
+    auto const right = window.segment((me + 1) % n);
+    CHECK(static_cast<int>(right[0]) == (me + 1) % n);
+    CHECK(static_cast<int>(right[1]) == 2 * ((me + 1) % n));
+    window.fence();
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("One-sided communication windows", "[mpi][window]") {
+  using namespace cxxmpi;  // NOLINT
+  auto const me = comm_world().rank();
+  auto const nprocs = static_cast<int>(comm_world().size());
+  auto const left = (me + nprocs - 1) % nprocs;
+  auto const right = (me + 1) % nprocs;
+
+  SECTION("Put and get under fence epochs") {
+    auto win = window<int>{comm_world(), 2};
+    REQUIRE(win.local().size() == 2);
+    std::ranges::fill(win.local(), -1);
+    const std::array value = {me};
+    {
+      auto epoch = win.fence_epoch();
+      win.put(std::span<const int>{value}, right, 1);
+    }
+    CHECK(win.local()[1] == left);
+
+    std::array<int, 1> fetched = {};
+    {
+      auto epoch = win.fence_epoch();
+      win.get(std::span{fetched}, left, 1);
+      epoch.close();
+      CHECK_FALSE(epoch.open());
+    }
+    CHECK(fetched[0] == (left + nprocs - 1) % nprocs);
+  }
+
+  SECTION("Accumulate over caller-owned memory") {
+    std::vector<long> sums(2, 0);
+    auto win = window<long>{comm_world(), std::span{sums}};
+    CHECK(win.local().data() == sums.data());
+    const std::array<long, 2> contribution = {me + 1, 1};
+    std::array<long, 2> previous = {};
+    {
+      auto epoch = win.fence_epoch();
+      win.accumulate(std::span<const long>{contribution}, 0, 0,
+                     std::plus<>{});
+    }
+    {
+      auto epoch = win.fence_epoch();
+      win.get_accumulate(std::span<const long>{contribution},
+                         std::span{previous}, 0, 0, MPI_NO_OP);
+    }
+    auto const total = static_cast<long>(nprocs) * (nprocs + 1) / 2;
+    CHECK(previous == std::array<long, 2>{total, nprocs});
+    if (me == 0) {
+      CHECK(sums == std::vector<long>{total, nprocs});
+    }
+  }
+
+  SECTION("Atomic counter and lock under passive target") {
+    auto win = window<int>{comm_world(), 1};
+    win.local()[0] = 0;
+    comm_world().barrier();
+
+    std::array<int, 3> tickets = {};
+    {
+      auto epoch = win.lock_all();
+      for (auto& ticket : tickets) {
+        win.fetch_and_op(1, ticket, 0, 0, std::plus<>{});
+        epoch.flush(0);
+      }
+    }
+    CHECK(std::ranges::is_sorted(tickets));
+    comm_world().barrier();
+
+    // Only the first process to swap the initial count claims the slot
+    int previous = -1;
+    {
+      auto epoch = win.lock(0);
+      win.compare_and_swap(-me - 1, 3 * nprocs, previous, 0, 0);
+    }
+    comm_world().barrier();
+    int final_value = 0;
+    {
+      auto epoch = win.lock(0, lock_type::shared);
+      win.get(std::span{&final_value, 1}, 0, 0);
+    }
+    auto const claimed = previous == 3 * nprocs ? 1 : 0;
+    CHECK(comm_world().allreduce(claimed, std::plus<>{}) == 1);
+    CHECK(final_value < 0);
+  }
+
+  SECTION("Post-start-complete-wait ring") {
+    auto win = window<int>{comm_world(), 1};
+    win.local()[0] = -1;
+    const std::array origins = {left};
+    const std::array targets = {right};
+    const std::array value = {me};
+    {
+      auto exposure = win.exposure_epoch(origins);
+      {
+        auto access = win.access_epoch(targets);
+        win.put(std::span<const int>{value}, right, 0);
+      }
+    }
+    CHECK(win.local()[0] == left);
+  }
+
+  SECTION("Dynamic window with attached memory") {
+    auto win = window<double>{comm_world()};
+    CHECK(win.local().empty());
+    std::vector<double> memory(1, -1.0);
+    win.attach(std::span{memory});
+
+    auto const addr = window<double>::address(memory.data());
+    auto const addresses = comm_world().allgather(addr);
+
+    const std::array value = {static_cast<double>(me)};
+    {
+      auto epoch = win.fence_epoch();
+      win.put(std::span<const double>{value}, right,
+              addresses[static_cast<std::size_t>(right)]);
+    }
+    CHECK(static_cast<int>(memory[0]) == left);
+    win.detach(std::span{memory});
+  }
+}